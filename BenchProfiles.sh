@@ -0,0 +1,38 @@
+#!/bin/sh
+# Builds every optimization profile from CMakePresets.json (release, LTO,
+# native, two-stage PGO) and runs the same benchmark suite against each, so
+# the fastest binary for the fleet can be picked from one report.
+#
+#   ./BenchProfiles.sh [bench-suite]     (default suite: all)
+set -e
+cd "$(dirname "$0")"
+SUITE="${1:-all}"
+REPORT="build-presets/bench-report.txt"
+mkdir -p build-presets
+: > "$REPORT"
+
+run_bench() { # $1 = label, $2 = binary
+  echo "==== $1 ====" | tee -a "$REPORT"
+  "$2" --bench "$SUITE" | tee -a "$REPORT"
+  "$2" --simulate 200000 | head -n 1 | tee -a "$REPORT"
+}
+
+for preset in release release-lto release-native; do
+  cmake --preset "$preset" >/dev/null
+  cmake --build --preset "$preset" --parallel >/dev/null
+  run_bench "$preset" "build-presets/$preset/tictactoe"
+done
+
+# Two-stage PGO: instrument, train on the self-play simulator, rebuild with the profiles
+rm -rf build-presets/pgo/pgo-data
+cmake --preset pgo-generate >/dev/null
+cmake --build --preset pgo-generate --parallel >/dev/null
+cmake --build --preset pgo-train >/dev/null
+if command -v llvm-profdata >/dev/null 2>&1 && ls build-presets/pgo/pgo-data/*.profraw >/dev/null 2>&1; then
+  llvm-profdata merge -o build-presets/pgo/pgo-data/default.profdata build-presets/pgo/pgo-data/*.profraw # Clang only
+fi
+cmake --preset pgo-use >/dev/null
+cmake --build --preset pgo-use --parallel >/dev/null
+run_bench "pgo-use" "build-presets/pgo/tictactoe"
+
+echo "Report written to $REPORT"
@@ -0,0 +1,18 @@
+#include "Differential.h" // Reference-vs-optimized rules checker
+#include <cstdio>
+#include <cstdlib>        // std::abort reports the input to libFuzzer
+#include <string>
+
+// libFuzzer entry point (build with -DTICTACTOE_FUZZER=ON, Clang only).
+// The first byte picks the variant; the rest is the move script.
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    if (size == 0) return 0;
+    std::string failure;
+    const bool ok = (data[0] & 1) ? Differential::checkQubic(data + 1, size - 1, &failure)
+                                  : Differential::checkClassic(data + 1, size - 1, &failure);
+    if (!ok) {
+        std::fprintf(stderr, "divergence: %s\n", failure.c_str());
+        std::abort();
+    }
+    return 0;
+}
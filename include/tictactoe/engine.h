@@ -0,0 +1,90 @@
+/* Embedding API for the tic-tac-toe engine (classic 3x3 board).
+ *
+ * Plain C so it can be called from any language with a C FFI. No function
+ * writes to the console. Handles come from an internal slab pool, so only a
+ * ttt_create that finds the pool exhausted touches the heap (ttt_destroy
+ * recycles the handle); moves, best-move queries and batch evaluation work
+ * on caller-owned memory. ttt_create / ttt_destroy are thread-safe.
+ *
+ * Cells are numbered 0..8 row by row (A1 = 0, A3 = 2, C3 = 8); a position is
+ * a pair of 9-bit masks with bit n set when cell n holds that mark. X always
+ * moves first, so the side to move follows from the mark counts.
+ */
+#ifndef TICTACTOE_ENGINE_H
+#define TICTACTOE_ENGINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(TTT_ENGINE_SHARED)
+#  if defined(_WIN32)
+#    if defined(TTT_ENGINE_BUILD)
+#      define TTT_API __declspec(dllexport)
+#    else
+#      define TTT_API __declspec(dllimport)
+#    endif
+#  else
+#    define TTT_API __attribute__((visibility("default")))
+#  endif
+#else
+#  define TTT_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TTT_API_VERSION 1
+
+/* Round outcome, mirroring GameState (X = human side, O = CPU side). */
+typedef enum ttt_state {
+    TTT_RUNNING = 0,
+    TTT_X_WINS = 1,
+    TTT_O_WINS = 2,
+    TTT_TIE = 3,
+    TTT_INVALID = -1 /* Position cannot arise in a legal game */
+} ttt_state;
+
+/* Return codes of ttt_make_move. */
+enum {
+    TTT_OK = 0,
+    TTT_ERR_ARG = -1,      /* Null game or cell outside 0..8 */
+    TTT_ERR_OCCUPIED = -2, /* Cell already holds a mark */
+    TTT_ERR_FINISHED = -3  /* The game is already over */
+};
+
+typedef struct ttt_position {
+    uint16_t x; /* Cells holding X */
+    uint16_t o; /* Cells holding O */
+} ttt_position;
+
+typedef struct ttt_result {
+    int8_t state;     /* ttt_state of the position */
+    int8_t best_move; /* Perfect-play move for the side to move, -1 if none */
+    int8_t value;     /* Side-to-move value: >0 forced win, 0 draw, <0 forced loss; faster wins score higher */
+    int8_t to_move;   /* 'X' or 'O' ('?' when invalid) */
+} ttt_result;
+
+typedef struct ttt_game ttt_game; /* Opaque */
+
+TTT_API int ttt_api_version(void);
+
+TTT_API ttt_game* ttt_create(void);                 /* Empty board, X to move; NULL on allocation failure */
+TTT_API void ttt_destroy(ttt_game* game);
+TTT_API void ttt_reset(ttt_game* game);
+
+TTT_API int ttt_make_move(ttt_game* game, int cell); /* TTT_OK or a TTT_ERR_* code */
+TTT_API ttt_state ttt_get_state(const ttt_game* game);
+TTT_API char ttt_side_to_move(const ttt_game* game);
+TTT_API ttt_position ttt_get_position(const ttt_game* game);
+
+TTT_API int ttt_best_move(const ttt_game* game);    /* -1 when the game is over */
+
+/* Evaluates count positions into out[0..count). Returns how many were valid. */
+TTT_API size_t ttt_evaluate_batch(const ttt_position* positions, ttt_result* out, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TICTACTOE_ENGINE_H */
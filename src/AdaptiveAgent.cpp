@@ -0,0 +1,105 @@
+#include "AdaptiveAgent.h" // Adaptive agent declarations
+#include "Bits.h"          // popcount64
+#include "Driver.h"        // GameState
+#include "Solver.h"        // Solved 3x3 values
+#include <algorithm>       // std::clamp
+#include <array>
+#include <chrono>          // RNG seed
+
+namespace {
+constexpr double kSmoothing = 0.3; // Weight of the latest round in the human's moving average
+constexpr double kGain = 0.5;      // Skill change per unit of (average - target)
+
+// Per-position move tiers for the side to move, indexed by Solver::index.
+struct MoveTiers {
+    std::array<std::uint16_t, Solver::kPositions> best{};   // Cells reaching the solved value
+    std::array<std::uint16_t, Solver::kPositions> second{}; // Best cells of the next lower outcome class (0 if none)
+};
+
+const MoveTiers& tiers() {
+    static const MoveTiers t = [] { // Built once, thread-safe (function-local static)
+        static constexpr int kPow3[9] = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+        const auto& solved = Solver::table();
+        MoveTiers m;
+        std::uint16_t x = 0, o = 0;
+        for (int idx = 0; idx < Solver::kPositions; ++idx) {
+            if (idx > 0) { // Odometer step from idx - 1: carry over cells that wrap from O back to empty
+                for (int cell = 0; cell < 9; ++cell) {
+                    const std::uint16_t bit = static_cast<std::uint16_t>(1u << cell);
+                    if (x & bit) { x = static_cast<std::uint16_t>(x & ~bit); o = static_cast<std::uint16_t>(o | bit); break; }
+                    if (o & bit) { o = static_cast<std::uint16_t>(o & ~bit); continue; }
+                    x = static_cast<std::uint16_t>(x | bit);
+                    break;
+                }
+            }
+            if (solved[static_cast<size_t>(idx)] == Solver::kUnreachable || TicTacToe::hasLine(x) || TicTacToe::hasLine(o)) continue;
+
+            const bool xToMove = popcount64(x) == popcount64(o);
+            int values[9];
+            int top = -100;
+            for (int cell = 0; cell < 9; ++cell) { // Child values straight from the table: -value(child)
+                values[cell] = Solver::kUnreachable;
+                if (((x | o) >> cell) & 1) continue;
+                values[cell] = -solved[static_cast<size_t>(idx + (xToMove ? 1 : 2) * kPow3[cell])];
+                top = std::max(top, values[cell]);
+            }
+            // Values are distance-scaled, so the next lower value is usually the same outcome a move
+            // slower. Step down a whole outcome class (win -> draw -> loss) instead, and within it
+            // take the highest value: the fastest win or the slowest loss.
+            auto outcome = [](int v) { return (v > 0) - (v < 0); };
+            int next = -100;
+            for (int cell = 0; cell < 9; ++cell)
+                if (values[cell] != Solver::kUnreachable && outcome(values[cell]) < outcome(top)) next = std::max(next, values[cell]);
+            for (int cell = 0; cell < 9; ++cell) {
+                if (values[cell] == Solver::kUnreachable) continue;
+                if (values[cell] == top) m.best[idx] = static_cast<std::uint16_t>(m.best[idx] | (1u << cell));
+                else if (values[cell] == next) m.second[idx] = static_cast<std::uint16_t>(m.second[idx] | (1u << cell));
+            }
+        }
+        return m;
+    }();
+    return t;
+}
+} // namespace
+
+AdaptiveAgent::AdaptiveAgent(double targetWinRate)
+    : target(std::clamp(targetWinRate, 0.0, 1.0)), rate(target),
+      rng(static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) | 1) {}
+
+void AdaptiveAgent::prepare() {
+    tiers();
+}
+
+void AdaptiveAgent::setTarget(double targetWinRate) {
+    target = std::clamp(targetWinRate, 0.0, 1.0);
+}
+
+double AdaptiveAgent::uniform() { // xorshift64
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return static_cast<double>(rng >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int AdaptiveAgent::pick(std::uint16_t cells) {
+    int skip = static_cast<int>(uniform() * popcount64(cells));
+    for (int cell = 0; cell < 9; ++cell)
+        if (((cells >> cell) & 1) && skip-- == 0) return cell;
+    return -1;
+}
+
+int AdaptiveAgent::chooseMove(std::uint16_t x, std::uint16_t o, bool perfect) {
+    const MoveTiers& t = tiers();
+    const int idx = Solver::index(x, o);
+    const std::uint16_t best = t.best[static_cast<size_t>(idx)];
+    if (best == 0) return -1;
+    const std::uint16_t second = t.second[static_cast<size_t>(idx)];
+    if (perfect || second == 0 || uniform() < skillLevel) return pick(best);
+    return pick(second);
+}
+
+void AdaptiveAgent::observe(GameState result) {
+    double score = result == GameState::HUMAN_WIN ? 1.0 : result == GameState::TIE ? 0.5 : 0.0;
+    rate = (1.0 - kSmoothing) * rate + kSmoothing * score;
+    skillLevel = std::clamp(skillLevel + kGain * (rate - target), 0.0, 1.0); // Human ahead of target: play better
+}
@@ -0,0 +1,50 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <cstdint>
+
+enum class GameState; // Driver.h
+
+// How the 3x3 computer opponent picks its moves.
+enum class Difficulty {
+    RANDOM,     // Any empty cell (the original behaviour)
+    ADAPTIVE,   // Mixes perfect and deliberately weaker moves to hit a target human win rate
+    PERFECT     // Always a solved-best move: never loses
+};
+
+// Opponent-modelling 3x3 agent.
+//
+// After every round observe() folds the human's result (win 1, tie 0.5,
+// loss 0) into an exponential moving average and nudges `skill`, the chance
+// of playing a perfect move, towards whatever brings that average to the
+// target. Otherwise the agent plays a move from the next outcome class below
+// the best, conceding one step (win -> draw, draw -> loss) rather than
+// blundering at random. Within that class it takes the best move: the
+// fastest win or the slowest loss. A slower win alone is not a concession,
+// so it is not used as one.
+//
+// Both move tiers come from masks precomputed for all 3^9 positions out of
+// the Solver table. prepare() builds them ahead of play (TicTacToe does so
+// when a solved-table difficulty is selected), so chooseMove() is a lookup
+// plus one random pick.
+class AdaptiveAgent {
+public:
+    explicit AdaptiveAgent(double targetWinRate = 0.4);
+
+    static void prepare();                                         // Build the move-tier tables now (idempotent)
+    void setTarget(double targetWinRate);
+    void reset() { rate = target; skillLevel = 0.5; }             // Forget the previous player (recycled sessions)
+    void seed(std::uint64_t value) { rng = value | 1; }           // Replace the time-based seed (xorshift needs non-zero)
+    int chooseMove(std::uint16_t x, std::uint16_t o, bool perfect); // Cell 0..8 for the side to move, -1 if none
+    void observe(GameState result);                                // Human is X: HUMAN_WIN, TIE or CPU_WIN
+
+    double skill() const { return skillLevel; }                    // Current chance of a perfect move
+    double humanRate() const { return rate; }                      // Smoothed human score per round
+
+private:
+    double target;
+    double rate;
+    double skillLevel = 0.5;
+    std::uint64_t rng;
+
+    int pick(std::uint16_t cells);                                 // Uniform set bit of a non-empty mask
+    double uniform();                                              // [0, 1)
+};
@@ -0,0 +1,60 @@
+#include "AllocProfile.h" // Counters the hooks feed
+
+// Global operator new/delete replacements feeding AllocProfile.
+//
+// Blocks come straight from malloc / aligned_alloc, so behaviour is the same
+// as the default operators. When the profile is running, each block is
+// measured with malloc_usable_size on the way in and out. glibc only; other
+// platforms keep the standard operators.
+
+#if defined(__GLIBC__)
+#include <cstdlib>
+#include <malloc.h>       // malloc_usable_size
+#include <new>
+
+namespace {
+void* allocate(std::size_t size) {
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    if (AllocProfile::active()) AllocProfile::onAlloc(malloc_usable_size(p));
+    return p;
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t align) {
+    const auto a = static_cast<std::size_t>(align);
+    const std::size_t rounded = (size + a - 1) / a * a; // aligned_alloc wants a multiple of the alignment
+    void* p = std::aligned_alloc(a, rounded ? rounded : a);
+    if (!p) throw std::bad_alloc();
+    if (AllocProfile::active()) AllocProfile::onAlloc(malloc_usable_size(p));
+    return p;
+}
+
+void release(void* p) noexcept {
+    if (!p) return;
+    if (AllocProfile::active()) AllocProfile::onFree(malloc_usable_size(p));
+    std::free(p);
+}
+
+const bool registered = (AllocProfile::setAvailable(), true);
+} // namespace
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return allocate(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return allocate(size); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t size, std::align_val_t align) { return allocateAligned(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return allocateAligned(size, align); }
+
+void operator delete(void* p) noexcept { release(p); }
+void operator delete[](void* p) noexcept { release(p); }
+void operator delete(void* p, std::size_t) noexcept { release(p); }
+void operator delete[](void* p, std::size_t) noexcept { release(p); }
+void operator delete(void* p, std::align_val_t) noexcept { release(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { release(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { release(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { release(p); }
+#endif
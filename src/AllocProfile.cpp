@@ -0,0 +1,128 @@
+#include "AllocProfile.h" // Allocation profile declarations
+#include <array>
+#include <atomic>
+#include <iomanip>        // Column formatting for the report
+#include <mutex>          // Guards the footprint list
+#include <ostream>
+
+namespace {
+constexpr int kTags = static_cast<int>(AllocTag::Count);
+
+struct TagStats {
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> frees{0};
+    std::atomic<std::uint64_t> bytes{0}; // Allocated over the run
+};
+
+struct Footprint {
+    const char* what = nullptr;
+    std::size_t bytes = 0;
+};
+
+// Plain globals: the hooks run before and after main and must never allocate.
+std::atomic<bool> running{false};
+std::atomic<bool> hooked{false};
+std::array<TagStats, kTags> tags;
+std::atomic<std::int64_t> live{0}; // Bytes allocated since start() minus bytes freed
+std::atomic<std::int64_t> peak{0};
+std::atomic<std::uint64_t> moves{0}, moveAllocations{0}, moveMax{0}, allocatingMoves{0}; // After each thread's first move
+std::atomic<std::uint64_t> firstMoves{0}, firstMoveAllocations{0};
+std::mutex footprintMutex;
+std::array<Footprint, 8> footprints;
+std::size_t footprintCount = 0;
+
+thread_local AllocTag currentTag = AllocTag::Other;
+thread_local std::uint64_t threadCount = 0;
+thread_local bool threadMoved = false;
+
+const char* tagName(int tag) {
+    static const char* const names[kTags] = {"other", "interface", "move", "search", "network", "cache", "broadcast"};
+    return names[tag];
+}
+
+void raise(std::atomic<std::uint64_t>& slot, std::uint64_t value) { // Lock-free running maximum
+    std::uint64_t seen = slot.load(std::memory_order_relaxed);
+    while (value > seen && !slot.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+}
+} // namespace
+
+void AllocProfile::start() { running.store(true, std::memory_order_release); }
+bool AllocProfile::active() { return running.load(std::memory_order_relaxed); }
+bool AllocProfile::available() { return hooked.load(std::memory_order_relaxed); }
+void AllocProfile::setAvailable() { hooked.store(true, std::memory_order_relaxed); }
+
+void AllocProfile::onAlloc(std::size_t bytes) {
+    TagStats& t = tags[static_cast<std::size_t>(currentTag)];
+    t.allocations.fetch_add(1, std::memory_order_relaxed);
+    t.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    ++threadCount;
+    const std::int64_t now = live.fetch_add(static_cast<std::int64_t>(bytes), std::memory_order_relaxed) +
+                             static_cast<std::int64_t>(bytes);
+    std::int64_t seen = peak.load(std::memory_order_relaxed);
+    while (now > seen && !peak.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {}
+}
+
+void AllocProfile::onFree(std::size_t bytes) {
+    tags[static_cast<std::size_t>(currentTag)].frees.fetch_add(1, std::memory_order_relaxed);
+    live.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+}
+
+std::uint64_t AllocProfile::threadAllocations() { return threadCount; }
+
+void AllocProfile::recordMove(std::uint64_t allocations) {
+    if (!threadMoved) { // Lazy per-thread setup (latency histograms, arenas) lands here; kept out of the budget
+        threadMoved = true;
+        firstMoves.fetch_add(1, std::memory_order_relaxed);
+        firstMoveAllocations.fetch_add(allocations, std::memory_order_relaxed);
+        return;
+    }
+    moves.fetch_add(1, std::memory_order_relaxed);
+    moveAllocations.fetch_add(allocations, std::memory_order_relaxed);
+    if (allocations) allocatingMoves.fetch_add(1, std::memory_order_relaxed);
+    raise(moveMax, allocations);
+}
+
+std::uint64_t AllocProfile::maxPerMove() { return moveMax.load(std::memory_order_relaxed); }
+
+void AllocProfile::footprint(const char* what, std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(footprintMutex);
+    if (footprintCount < footprints.size()) footprints[footprintCount++] = {what, bytes};
+}
+
+void AllocProfile::report(std::ostream& out) {
+    if (!active()) return;
+    out << "---- allocations ----\n";
+    if (!available()) {
+        out << "(allocation hooks are not available on this platform)\n";
+        return;
+    }
+    out << std::left << std::setw(12) << "tag" << std::right << std::setw(12) << "allocs" << std::setw(12) << "frees"
+        << std::setw(14) << "KiB" << "\n";
+    for (int i = 0; i < kTags; ++i) {
+        const TagStats& t = tags[static_cast<std::size_t>(i)];
+        const std::uint64_t n = t.allocations.load(std::memory_order_relaxed);
+        const std::uint64_t f = t.frees.load(std::memory_order_relaxed);
+        if (n == 0 && f == 0) continue;
+        out << std::left << std::setw(12) << tagName(i) << std::right << std::setw(12) << n << std::setw(12) << f
+            << std::setw(14) << t.bytes.load(std::memory_order_relaxed) / 1024 << "\n";
+    }
+    out << "live " << live.load(std::memory_order_relaxed) / 1024 << " KiB, peak "
+        << peak.load(std::memory_order_relaxed) / 1024 << " KiB (since start)\n";
+    const std::uint64_t first = firstMoves.load(std::memory_order_relaxed);
+    if (first)
+        out << "first CPU move on " << first << " thread(s): " << firstMoveAllocations.load(std::memory_order_relaxed)
+            << " allocations (per-thread setup)\n";
+    const std::uint64_t m = moves.load(std::memory_order_relaxed);
+    if (m) {
+        out << std::fixed << std::setprecision(2) << "later CPU moves: " << m << ", allocations per move "
+            << static_cast<double>(moveAllocations.load(std::memory_order_relaxed)) / static_cast<double>(m) << " mean, "
+            << maxPerMove() << " max; " << allocatingMoves.load(std::memory_order_relaxed) << " moves allocated\n";
+        out.unsetf(std::ios::floatfield);
+    }
+    std::lock_guard<std::mutex> lock(footprintMutex);
+    for (std::size_t i = 0; i < footprintCount; ++i)
+        out << footprints[i].what << ": " << footprints[i].bytes << " bytes\n";
+}
+
+AllocScope::AllocScope(AllocTag tag) : previous(currentTag) { currentTag = tag; }
+AllocScope::~AllocScope() { currentTag = previous; }
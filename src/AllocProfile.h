@@ -0,0 +1,81 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd> // std::ostream forward declaration
+
+// Subsystems that allocations are charged to. A thread's current tag is set
+// by the innermost AllocScope and defaults to Other.
+enum class AllocTag : std::uint8_t {
+    Other,      // Startup, the standard library, anything unscoped
+    Interface,  // Prompts, input and rendering
+    Move,       // computerMove: rules and the classic agents
+    Search,     // Qubic alpha-beta and MCTS
+    Network,    // ValueNet loading and inference
+    Cache,      // Qubic move cache
+    Broadcast,  // Spectator channels
+    Count       // Number of tags (keep last)
+};
+
+// Heap allocation profile (--alloc-profile).
+//
+// The app replaces global operator new/delete (AllocHooks.cpp). Once start()
+// has been called, each hook charges the block to the calling thread's tag.
+// Per tag it counts allocations, frees and bytes. It also tracks the live
+// byte total and its peak. Before start() a hook costs one relaxed atomic
+// load.
+//
+// Sizes come from malloc_usable_size, so a block is counted at the same
+// size when it is allocated and when it is freed. The hooks are glibc only.
+// Elsewhere available() is false and the report says so.
+//
+// A MoveAllocProbe at the top of each computerMove() counts the allocations
+// made during that call on the calling thread. A thread's first move also
+// pays for lazy per-thread setup, such as its latency histogram, so it is
+// reported on its own line. For the later moves, report() shows the mean and
+// the maximum per move, and --alloc-budget N fails the run when one of them
+// exceeds N.
+class AllocProfile {
+public:
+    static void start();
+    static bool active();                       // start() was called
+    static bool available();                    // Hooks are compiled into this binary
+    static void setAvailable();                 // Called by the hooks' static initializer
+
+    static void onAlloc(std::size_t bytes);     // Hooks only; never allocate
+    static void onFree(std::size_t bytes);
+    static std::uint64_t threadAllocations();   // Allocations made so far by the calling thread
+
+    static void recordMove(std::uint64_t allocations);
+    static std::uint64_t maxPerMove();          // Over moves after each thread's first
+    static void footprint(const char* what, std::size_t bytes); // Fixed cost listed in the report (object sizes, untracked tables)
+    static void report(std::ostream& out);
+};
+
+// Charges the enclosing scope's allocations on this thread to one tag.
+class AllocScope {
+public:
+    explicit AllocScope(AllocTag tag);
+    ~AllocScope();
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+private:
+    AllocTag previous;
+};
+
+// Top of computerMove(): tags the call and counts its allocations.
+class MoveAllocProbe {
+public:
+    explicit MoveAllocProbe(AllocTag tag = AllocTag::Move)
+        : scope(tag), armed(AllocProfile::active()), before(armed ? AllocProfile::threadAllocations() : 0) {}
+    ~MoveAllocProbe() {
+        if (armed) AllocProfile::recordMove(AllocProfile::threadAllocations() - before);
+    }
+    MoveAllocProbe(const MoveAllocProbe&) = delete;
+    MoveAllocProbe& operator=(const MoveAllocProbe&) = delete;
+
+private:
+    AllocScope scope;
+    bool armed;
+    std::uint64_t before;
+};
@@ -0,0 +1,58 @@
+#include "Arena.h" // Arena declarations
+#include <algorithm> // std::max
+#include <cstdlib>   // std::malloc / std::free
+#include <new>       // std::bad_alloc
+
+Arena::Arena(std::size_t initialBytes) {
+    addChunk(initialBytes);
+}
+
+Arena::~Arena() {
+    for (Chunk& c : chunks) std::free(c.data);
+}
+
+Arena& Arena::local() {
+    thread_local Arena arena;
+    return arena;
+}
+
+void Arena::addChunk(std::size_t atLeast) {
+    std::size_t size = std::max(atLeast, chunks.empty() ? atLeast : chunks.back().size * 2);
+    unsigned char* data = static_cast<unsigned char*>(std::malloc(size));
+    if (!data) throw std::bad_alloc();
+    ++heapAllocations;
+    chunks.push_back({data, size});
+}
+
+void* Arena::allocate(std::size_t bytes, std::size_t align) {
+    for (;;) {
+        Chunk& c = chunks[current];
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(c.data);
+        std::uintptr_t at = (base + used + align - 1) & ~static_cast<std::uintptr_t>(align - 1);
+        if (at + bytes <= base + c.size) {
+            used = static_cast<std::size_t>(at - base) + bytes;
+            return reinterpret_cast<void*>(at);
+        }
+        if (current + 1 == chunks.size()) addChunk(bytes + align);
+        ++current; // Move on to the next chunk, starting empty
+        used = 0;
+    }
+}
+
+void Arena::rewind(Mark m) {
+    if (m.chunk == 0 && m.used == 0 && current > 0) { // Back to empty after spilling: merge into one chunk
+        std::size_t total = 0;
+        for (const Chunk& c : chunks) total += c.size;
+        for (Chunk& c : chunks) std::free(c.data);
+        chunks.clear();
+        addChunk(total);
+    }
+    current = m.chunk < chunks.size() ? m.chunk : 0;
+    used = m.chunk < chunks.size() ? m.used : 0;
+}
+
+std::size_t Arena::bytesReserved() const {
+    std::size_t total = 0;
+    for (const Chunk& c : chunks) total += c.size;
+    return total;
+}
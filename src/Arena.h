@@ -0,0 +1,99 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bump allocator for per-move search scratch (tree nodes, move lists).
+//
+// Allocation is a pointer bump inside the current chunk. Nothing is freed
+// one piece at a time: an ArenaScope rewinds the arena to where it was when
+// the scope opened. Each thread has its own arena (Arena::local()), so no
+// locking is needed. A rewind to the start merges the chunks used into a
+// single chunk of their combined size, so after a few moves every request
+// fits in the first chunk and search stops touching the heap.
+class Arena {
+public:
+    explicit Arena(std::size_t initialBytes = 64 * 1024);
+    ~Arena();
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    static Arena& local();                                   // This thread's arena
+
+    void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t));
+    template <class T>
+    T* allocate(std::size_t count) { return static_cast<T*>(allocate(count * sizeof(T), alignof(T))); }
+
+    struct Mark {
+        std::size_t chunk;
+        std::size_t used;
+    };
+    Mark mark() const { return {current, used}; }
+    void rewind(Mark m);                                     // Drop everything allocated since m
+
+    std::size_t bytesReserved() const;                       // Heap held by the arena
+    std::uint64_t chunkAllocations() const { return heapAllocations; } // Heap calls made so far
+
+private:
+    struct Chunk {
+        unsigned char* data;
+        std::size_t size;
+    };
+    std::vector<Chunk> chunks;
+    std::size_t current = 0;                                 // Chunk being bumped
+    std::size_t used = 0;                                    // Bytes used in it
+    std::uint64_t heapAllocations = 0;
+
+    void addChunk(std::size_t atLeast);
+};
+
+// Rewinds the arena on scope exit; nest freely.
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena& a) : arena(a), start(a.mark()) {}
+    ~ArenaScope() { arena.rewind(start); }
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    Arena& arena;
+    Arena::Mark start;
+};
+
+// Growable array of trivially copyable T in an arena. Growing copies into a
+// fresh block and leaves the old one for the next rewind.
+template <class T>
+class ArenaVector {
+public:
+    ArenaVector() = default;
+    ArenaVector(Arena& a, std::size_t initialCapacity) { reset(a, initialCapacity); }
+
+    void reset(Arena& a, std::size_t initialCapacity) { // Empty, backed by a fresh block of a
+        arena = &a;
+        items = a.allocate<T>(initialCapacity);
+        count = 0;
+        capacity = initialCapacity;
+    }
+
+    void push_back(const T& v) {
+        if (count == capacity) grow();
+        items[count++] = v;
+    }
+    T& operator[](std::size_t i) { return items[i]; }
+    const T& operator[](std::size_t i) const { return items[i]; }
+    std::size_t size() const { return count; }
+
+private:
+    Arena* arena = nullptr;
+    T* items = nullptr;
+    std::size_t count = 0;
+    std::size_t capacity = 0;
+
+    void grow() {
+        std::size_t bigger = capacity ? capacity * 2 : 16;
+        T* fresh = arena->allocate<T>(bigger);
+        for (std::size_t i = 0; i < count; ++i) fresh[i] = items[i];
+        items = fresh;
+        capacity = bigger;
+    }
+};
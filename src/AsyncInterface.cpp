@@ -0,0 +1,195 @@
+#include "AsyncInterface.h" // Async interface declarations
+#include "MoveParser.h"     // Shared move scanner and messages
+#include "Bits.h"           // lowestBit64 for the computer's reply
+#include <iostream>
+#include <sstream>          // Per-session output buffer
+
+#if !defined(_WIN32)
+#include <csignal>          // Ignore SIGPIPE from departed clients
+#include <sys/socket.h>
+#include <sys/un.h>         // sockaddr_un
+#include <unistd.h>         // unlink / close
+#endif
+
+namespace {
+constexpr int kStdin = 0;
+constexpr int kStdout = 1;
+
+// Returns the cell played, or -1 after reporting bad input
+int humanTurn(TicTacToe& g, std::string_view line, std::ostream& out) {
+    ParsedMove move = MoveParser::classic(line);
+    if (move.status != ParseStatus::OK) {
+        out << MoveParser::classicError(move.status);
+        return -1;
+    }
+    int cell = move.cell;
+    if (!g.isAvailable(cell / 3, cell % 3)) { // Checked here so playerMove never reports to the console
+        out << "Invalid move. Cell is taken or out of range.\n";
+        return -1;
+    }
+    g.playerMove(cell / 3, cell % 3);
+    return cell;
+}
+
+int humanTurn(Qubic& g, std::string_view line, std::ostream& out) {
+    ParsedMove move = MoveParser::qubic(line);
+    if (move.status != ParseStatus::OK) {
+        out << MoveParser::qubicError(move.status);
+        return -1;
+    }
+    int cell = move.cell;
+    if (!g.isAvailable(cell)) {
+        out << "Invalid move. Use layer 1-4, row A-D and column 1-4, and choose an empty cell.\n";
+        return -1;
+    }
+    g.playerMove(cell);
+    return cell;
+}
+
+void drawTurn(const TicTacToe& g, bool coach, std::ostream& out) {
+    if (coach) g.drawAnalysis(out);
+    else g.drawBoard(out);
+}
+void drawTurn(const Qubic& g, bool, std::ostream& out) { g.drawBoard(out); } // Nothing to analyse with
+
+const char* prompt(const TicTacToe&) { return "Enter row (A-C) and column (1-3), e.g. B 2: "; }
+const char* prompt(const Qubic&) { return "Enter layer (1-4), row (A-D) and column (1-4), e.g. 2 B 3: "; }
+
+void computerTurn(TicTacToe& g, std::ostream&) { g.computerMove(); } // Silent; the next board shows the reply
+void computerTurn(Qubic& g, std::ostream& out) { g.computerMove(out); }
+
+int cells(const TicTacToe&) { return 9; }
+int cells(const Qubic&) { return 64; }
+
+// The computer's move is the bit that appears in occupied() across its turn
+int addedCell(std::uint64_t before, std::uint64_t after) {
+    const std::uint64_t added = after & ~before;
+    return added ? lowestBit64(added) : -1;
+}
+} // namespace
+
+AsyncInterface::AsyncInterface(const AsyncOptions& opts) : options(opts), loop(opts.threads), spectators(hub) {}
+
+void AsyncInterface::start(int inFd, int outFd, bool closeWhenDone) {
+    if (options.variant == Variant::QUBIC) {
+        Qubic* game = qubicGames.acquire(); // Recycled when a session has ended; configured the same every time
+        game->resetSession();
+        game->setAgent(options.agent, options.moveMs);
+        game->setValueNet(options.net);
+        game->setMoveCache(options.cache);
+        session(qubicGames, game, inFd, outFd, closeWhenDone);
+    } else {
+        TicTacToe* game = classicGames.acquire();
+        game->resetSession();
+        game->setDifficulty(options.difficulty, options.targetRate);
+        session(classicGames, game, inFd, outFd, closeWhenDone);
+    }
+}
+
+// Interface::loop with co_await at each point where the blocking version waits
+template <class Game, std::size_t kSlab>
+Task AsyncInterface::session(GamePool<Game, kSlab>& pool, Game* game, int inFd, int outFd, bool closeWhenDone) {
+    struct Release { // Also runs if the frame is destroyed while suspended
+        GamePool<Game, kSlab>& pool;
+        Game* game;
+        ~Release() { pool.release(game); }
+    } release{pool, game};
+    Game& g = *game;
+    std::ostringstream out;
+    std::shared_ptr<GameChannel> channel = broadcasting ? hub.open(cells(g)) : nullptr; // Published from the loop thread only
+    auto flush = [&] {
+        loop.write(outFd, out.str());
+        out.str({});
+    };
+
+    bool playing = true;
+    while (playing) {
+        g.resetGame();
+        if (channel) channel->publishReset();
+
+        while (g.getState() == GameState::RUNNING) {
+            drawTurn(g, options.coach, out);
+            out << prompt(g);
+            flush();
+
+            std::optional<std::string> line = co_await loop.readLine(inFd);
+            if (!line) { playing = false; break; } // Player left mid-round
+
+            int cell = humanTurn(g, *line, out);
+            if (cell < 0) continue; // invalid input or taken cell; reprompt
+            if (channel) channel->publishMove(cell, 'X', g.getState());
+
+            if (g.getState() == GameState::RUNNING) {
+                std::uint64_t before = g.occupied();
+                co_await loop.offload([&] { computerTurn(g, out); }); // Session is suspended; out is not shared
+                int reply = addedCell(before, g.occupied());
+                if (channel && reply >= 0) channel->publishMove(reply, 'O', g.getState());
+            }
+        }
+        if (!playing) break;
+
+        g.drawBoard(out);
+        g.printResult(out);
+        g.printScores(out);
+        out << "Play again? (y/n): ";
+        flush();
+
+        std::optional<std::string> again = co_await loop.readLine(inFd);
+        playing = again && MoveParser::yes(*again);
+    }
+
+    out << "Thanks for playing!\n";
+    flush();
+    if (channel) hub.retire(channel);
+    if (closeWhenDone) loop.close(inFd);
+}
+
+#if !defined(_WIN32)
+
+int AsyncInterface::runStdio() {
+    std::signal(SIGPIPE, SIG_IGN);
+    start(kStdin, kStdout, false);
+    return loop.run();
+}
+
+int AsyncInterface::serve(const char* socketPath) {
+    std::signal(SIGPIPE, SIG_IGN); // A client hanging up must not kill the server
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (std::char_traits<char>::length(socketPath) >= sizeof addr.sun_path) {
+        std::cerr << "Socket path too long: " << socketPath << "\n";
+        return 2;
+    }
+    std::char_traits<char>::copy(addr.sun_path, socketPath, std::char_traits<char>::length(socketPath));
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ::unlink(socketPath); // Replace a stale socket from an earlier run
+    if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) < 0 || ::listen(fd, 64) < 0) {
+        std::cerr << "Cannot listen on " << socketPath << "\n";
+        if (fd >= 0) ::close(fd);
+        return 2;
+    }
+    std::cerr << "Serving on " << socketPath << "\n";
+    std::string watchPath = std::string(socketPath) + ".watch";
+    broadcasting = spectators.start(watchPath.c_str());
+    if (broadcasting) std::cerr << "Spectators on " << watchPath << "\n";
+    loop.listen(fd, [this](int client) { start(client, client, true); });
+    int rc = loop.run();
+    ::close(fd);
+    ::unlink(socketPath);
+    return rc;
+}
+
+#else // Windows: the event loop is POSIX only
+
+int AsyncInterface::runStdio() {
+    std::cerr << "--async is not supported on this platform.\n";
+    return 2;
+}
+
+int AsyncInterface::serve(const char*) {
+    std::cerr << "--serve is not supported on this platform.\n";
+    return 2;
+}
+
+#endif
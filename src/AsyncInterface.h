@@ -0,0 +1,49 @@
+#pragma once // Ensure the header is included only once during compilation
+#include "Broadcast.h" // Spectator channels for served games
+#include "Driver.h"    // TicTacToe, Variant, Difficulty
+#include "EventLoop.h" // Coroutine scheduler and Task
+#include "GamePool.h"  // Session games recycled across connections
+#include "Qubic.h"     // Qubic and QubicAgent
+
+// Settings every session starts from.
+struct AsyncOptions {
+    Variant variant = Variant::CLASSIC;
+    QubicAgent agent = QubicAgent::ALPHA_BETA;
+    int moveMs = 500;                          // Qubic search budget per move
+    const ValueNet* net = nullptr;             // Shared, read-only Qubic evaluator
+    MoveCache* cache = nullptr;                // Qubic replies shared by every session
+    Difficulty difficulty = Difficulty::RANDOM;
+    double targetRate = 0.4;
+    int threads = 0;                           // AI worker threads (0 = hardware concurrency)
+    bool coach = false;                        // Classic: show every empty cell's value on the human's turn
+};
+
+// Coroutine version of Interface. Each session plays the same
+// round/score/replay flow, but it waits for input with co_await instead of
+// blocking on cin, and computer moves run on the worker pool. Because of
+// that, one loop thread can serve many players at once (--serve), and a slow
+// Qubic search never stalls the other sessions. Client sockets are
+// non-blocking with per-connection output queues (see EventLoop), so a
+// client that stops reading only holds up its own session, and is dropped
+// once its queue or an input line grows past the loop's limits. When
+// serving, every game is also published to spectators on PATH.watch as
+// per-move deltas.
+class AsyncInterface {
+public:
+    explicit AsyncInterface(const AsyncOptions& options);
+    int runStdio();                        // One session on stdin/stdout (--async)
+    int serve(const char* socketPath);     // One session per connection on a Unix socket (--serve)
+
+private:
+    AsyncOptions options;
+    GamePool<TicTacToe> classicGames; // Loop thread only; declared before loop so they outlive its sessions
+    GamePool<Qubic, 16> qubicGames;
+    EventLoop loop;
+    BroadcastHub hub;
+    SpectatorServer spectators;   // Declared after hub: stops before the hub goes away
+    bool broadcasting = false;
+
+    void start(int inFd, int outFd, bool closeWhenDone); // Launch a session for the configured variant
+    template <class Game, std::size_t kSlab>
+    Task session(GamePool<Game, kSlab>& pool, Game* game, int inFd, int outFd, bool closeWhenDone); // Releases game when done
+};
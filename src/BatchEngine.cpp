@@ -0,0 +1,101 @@
+#include "BatchEngine.h" // Batch engine declarations
+#include "Rules.h"       // Unrolled 3x3 line checks
+#include <algorithm>     // std::min
+
+namespace {
+std::uint64_t mix(std::uint64_t v) { // splitmix64: distinct lane seeds from one batch seed
+    v += 0x9E3779B97F4A7C15ULL;
+    v = (v ^ (v >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    v = (v ^ (v >> 27)) * 0x94D049BB133111EBULL;
+    return v ^ (v >> 31);
+}
+} // namespace
+
+BatchEngine::BatchEngine(std::size_t lanes, std::uint64_t seed)
+    : xs(lanes), os(lanes), rngs(lanes), status(lanes) {
+    for (std::size_t i = 0; i < lanes; ++i) rngs[i] = static_cast<std::uint32_t>(mix(seed + i)) | 1;
+}
+
+void BatchEngine::start(std::size_t games) {
+    live = std::min(games, xs.size());
+    std::fill(xs.begin(), xs.begin() + static_cast<std::ptrdiff_t>(live), 0);
+    std::fill(os.begin(), os.begin() + static_cast<std::ptrdiff_t>(live), 0);
+    ply = 0; // RNG states carry on from the previous batch
+}
+
+template <bool XMoves>
+void BatchEngine::advance() {
+    std::uint16_t* __restrict mine = XMoves ? xs.data() : os.data();
+    const std::uint16_t* __restrict theirs = XMoves ? os.data() : xs.data();
+    std::uint32_t* __restrict rng = rngs.data();
+    std::uint8_t* __restrict state = status.data();
+    const std::uint32_t empties = static_cast<std::uint32_t>(9 - ply); // Same in every lane
+    const std::uint8_t win = static_cast<std::uint8_t>(XMoves ? GameState::HUMAN_WIN : GameState::CPU_WIN);
+    const std::uint8_t full = static_cast<std::uint8_t>(empties == 1 ? GameState::TIE : GameState::RUNNING);
+    const std::size_t n = live;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint32_t r = rng[i]; // xorshift32
+        r ^= r << 13;
+        r ^= r >> 17;
+        r ^= r << 5;
+        rng[i] = r;
+        const std::uint32_t pick = ((r >> 16) * empties) >> 16; // Uniform in [0, empties)
+        const std::uint32_t open = ~static_cast<std::uint32_t>(mine[i] | theirs[i]) & TicTacToe::kFullMask;
+        std::uint32_t bit = 0, seen = 0;
+        for (int c = 0; c < 9; ++c) { // pick-th empty cell, without branches
+            const std::uint32_t empty = (open >> c) & 1;
+            bit |= (empty & (seen == pick)) << c;
+            seen += empty;
+        }
+        const auto after = static_cast<std::uint16_t>(mine[i] | bit);
+        mine[i] = after;
+        state[i] = Rules<ClassicGeometry>::hasLine(after) ? win : full;
+    }
+}
+
+void BatchEngine::retire() {
+    std::uint64_t xWins = 0, oWins = 0, ties = 0;
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < live; ++i) {
+        const std::uint8_t s = status[i];
+        xWins += s == static_cast<std::uint8_t>(GameState::HUMAN_WIN);
+        oWins += s == static_cast<std::uint8_t>(GameState::CPU_WIN);
+        ties += s == static_cast<std::uint8_t>(GameState::TIE);
+        xs[kept] = xs[i]; // Unconditional copy; only running lanes advance the write position
+        os[kept] = os[i];
+        rngs[kept] = rngs[i];
+        kept += s == static_cast<std::uint8_t>(GameState::RUNNING);
+    }
+    totals.xWins += xWins;
+    totals.oWins += oWins;
+    totals.ties += ties;
+    totals.games += xWins + oWins + ties;
+    live = kept;
+}
+
+std::size_t BatchEngine::step() {
+    if (live == 0) return 0;
+    if (ply % 2 == 0) advance<true>();
+    else advance<false>();
+    ++ply;
+    totals.moves += live;
+    if (ply >= 5) retire(); // Nobody has a line before X's third mark
+    return live;
+}
+
+BatchStats BatchEngine::play(std::uint64_t games) {
+    const BatchStats before = totals;
+    for (std::uint64_t left = games; left > 0;) {
+        start(static_cast<std::size_t>(std::min<std::uint64_t>(left, xs.size())));
+        left -= live;
+        while (step() > 0) {}
+    }
+    BatchStats run;
+    run.games = totals.games - before.games;
+    run.xWins = totals.xWins - before.xWins;
+    run.oWins = totals.oWins - before.oWins;
+    run.ties = totals.ties - before.ties;
+    run.moves = totals.moves - before.moves;
+    return run;
+}
@@ -0,0 +1,53 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Outcome counts of the games a BatchEngine has finished.
+struct BatchStats {
+    std::uint64_t games = 0;
+    std::uint64_t xWins = 0;
+    std::uint64_t oWins = 0;
+    std::uint64_t ties = 0;
+    std::uint64_t moves = 0;   // Marks placed over all games
+};
+
+// Random-vs-random 3x3 self-play, many games at a time.
+//
+// Stepping TicTacToe objects one at a time spends most of its time on
+// branches that depend on each game. Here the games live as structure of
+// arrays: one X mask, one O mask and one RNG state per lane. A step makes
+// one move in every active game, with one straight-line loop over the
+// lanes: it picks a random empty cell, sets its bit and tests the eight
+// lines. The loop has no data-dependent branches, so the compiler
+// vectorizes it.
+//
+// All games of a batch start together and advance in lockstep. The side to
+// move and the number of empty cells are therefore the same in every lane,
+// and they are scalars rather than arrays. Games end from the fifth mark
+// on. From then on, finished games are tallied and the running ones are
+// compacted to the front, so later steps only touch live lanes.
+class BatchEngine {
+public:
+    explicit BatchEngine(std::size_t lanes = 4096, std::uint64_t seed = 1);
+
+    void start(std::size_t games);  // New empty boards in the first min(games, lanes) lanes
+    std::size_t step();             // One move in every running game; returns how many still run
+    BatchStats play(std::uint64_t games); // Whole batches until that many games are finished; adds to stats()
+
+    std::size_t running() const { return live; }
+    const BatchStats& stats() const { return totals; }
+
+private:
+    std::vector<std::uint16_t> xs;     // X marks per lane (row*3 + col)
+    std::vector<std::uint16_t> os;     // O marks per lane
+    std::vector<std::uint32_t> rngs;   // xorshift32 state per lane
+    std::vector<std::uint8_t> status;  // GameState after the last step (scratch for compaction)
+    std::size_t live = 0;              // Running games occupy lanes [0, live)
+    int ply = 0;                       // Marks on every running board
+    BatchStats totals;
+
+    template <bool XMoves>
+    void advance();                    // The vectorized move + win check over [0, live)
+    void retire();                     // Tally finished lanes and compact the running ones
+};
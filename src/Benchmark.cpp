@@ -0,0 +1,318 @@
+#include "Benchmark.h" // Benchmark suite declarations
+#include "Arena.h"     // Search scratch arena statistics
+#include "BatchEngine.h" // Structure-of-arrays self-play
+#include "Broadcast.h" // Spectator ring fan-out
+#include "GamePool.h"  // Session churn through the pool
+#include "MoveParser.h" // Chunked line reader and move scanner
+#include "Qubic.h"     // Qubic alpha-beta and MCTS agents
+#include "ThreatSearch.h" // Qubic forced-win search
+#include "Ultimate.h"  // Ultimate MCTS agent
+#include "ValueNet.h"  // Network inference throughput
+#include <chrono>
+#include <cstdio>      // std::remove for the parse script
+#include <filesystem>  // Temp directory for the parse script
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>     // Redrawn board size for the broadcast comparison
+#include <thread>      // Broadcast subscribers
+#include <vector>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>        // _open / _close
+#else
+#include <fcntl.h>     // open
+#include <unistd.h>    // close
+#endif
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+void report(std::ostream& out, const std::string& name, std::uint64_t work, const char* unit, double seconds) {
+    double rate = seconds > 0 ? static_cast<double>(work) / seconds : 0.0;
+    out << std::left << std::setw(28) << name << std::right << std::setw(12) << work << " " << std::setw(6) << unit
+        << std::fixed << std::setprecision(1) << std::setw(10) << seconds * 1e3 << " ms"
+        << std::setprecision(3) << std::setw(12) << rate / 1e6 << " M" << unit << "/s\n";
+    out.unsetf(std::ios::floatfield);
+}
+
+// A few fixed Qubic positions: empty, early and crowded middle game.
+QubicBoard qubicPosition(int which) {
+    static const int scripts[3][12] = {
+        {-1},
+        {0, 21, 63, 42, 3, -1},
+        {0, 21, 63, 42, 3, 12, 48, 60, 5, 10, 22, -1},
+    };
+    QubicBoard board;
+    for (int i = 0; scripts[which][i] >= 0; ++i) board.play(scripts[which][i]);
+    return board;
+}
+
+void benchQubic(std::ostream& out) {
+    for (int p = 0; p < 3; ++p) {
+        QubicSearch search;
+        QubicBoard board = qubicPosition(p);
+        auto start = Clock::now();
+        search.searchFixedDepth(board, 4);
+        double secs = std::chrono::duration<double>(Clock::now() - start).count();
+        report(out, "qubic/alphabeta d4 pos" + std::to_string(p), search.lastNodes(), "nodes", secs);
+    }
+    Mcts<QubicBoard> mcts(500, 12345);
+    auto start = Clock::now();
+    mcts.chooseMove(qubicPosition(1));
+    report(out, "qubic/mcts 500ms", mcts.lastIterations(), "iters",
+           std::chrono::duration<double>(Clock::now() - start).count());
+}
+
+// Threat-space search over middle-game positions reached by seeded random play.
+void benchThreats(std::ostream& out) {
+    std::uint64_t rng = 0x5DEECE66DULL;
+    auto next = [&rng] { rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17; return rng; };
+    ThreatSearch tss;
+    std::uint64_t totalNodes = 0;
+    int positions = 0, wins = 0;
+    double secs = 0.0;
+    while (positions < 500) {
+        QubicBoard board;
+        std::array<std::uint8_t, 64> moves;
+        for (int ply = 0; ply < 16 && board.state() == GameState::RUNNING; ++ply)
+            board.play(moves[next() % static_cast<std::uint64_t>(board.legalMoves(moves))]);
+        if (board.state() != GameState::RUNNING) continue;
+        int first;
+        auto start = Clock::now();
+        wins += tss.findWin(board, first) ? 1 : 0;
+        secs += std::chrono::duration<double>(Clock::now() - start).count();
+        totalNodes += tss.lastNodes();
+        ++positions;
+    }
+    report(out, "qubic/threats 500 pos (" + std::to_string(wins) + " won)", totalNodes, "nodes", secs);
+}
+
+// Value-network inference on one core: single calls, then float and int8 batches,
+// then a fixed-depth search using the network at the frontier.
+void benchNn(std::ostream& out) {
+    ValueNet net;
+    net.randomize(12345); // Throughput does not depend on the weights
+    std::uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    auto next = [&rng] { rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17; return rng; };
+    std::vector<QubicBoard> positions;
+    while (positions.size() < 4096) {
+        QubicBoard board;
+        std::array<std::uint8_t, 64> moves;
+        const int plies = static_cast<int>(next() % 32);
+        for (int ply = 0; ply < plies && board.state() == GameState::RUNNING; ++ply)
+            board.play(moves[next() % static_cast<std::uint64_t>(board.legalMoves(moves))]);
+        if (board.state() == GameState::RUNNING) positions.push_back(board);
+    }
+    std::vector<float> values(positions.size());
+    constexpr int kRounds = 16;
+    volatile float sink = 0.0f; // Keeps the single-call loop from being optimized away
+
+    auto start = Clock::now();
+    for (int r = 0; r < kRounds; ++r)
+        for (const QubicBoard& board : positions) sink = sink + net.evaluate(board);
+    report(out, "nn/float single", kRounds * positions.size(), "evals",
+           std::chrono::duration<double>(Clock::now() - start).count());
+
+    for (ValueNet::Precision p : {ValueNet::Precision::FLOAT, ValueNet::Precision::INT8}) {
+        net.setPrecision(p);
+        start = Clock::now();
+        for (int r = 0; r < kRounds; ++r) net.evaluateBatch(positions.data(), static_cast<int>(positions.size()), values.data());
+        report(out, p == ValueNet::Precision::FLOAT ? "nn/float batch64" : "nn/int8 batch64", kRounds * positions.size(), "evals",
+               std::chrono::duration<double>(Clock::now() - start).count());
+    }
+
+    net.setPrecision(ValueNet::Precision::FLOAT);
+    QubicSearch search;
+    search.setValueNet(&net);
+    start = Clock::now();
+    search.searchFixedDepth(qubicPosition(1), 4);
+    report(out, "qubic/alphabeta+nn d4 pos1", search.lastNodes(), "nodes",
+           std::chrono::duration<double>(Clock::now() - start).count());
+}
+
+// Session churn: heap-allocated games versus the slab pool, 64 sessions live at a time,
+// then how often MCTS still reaches the heap once the thread's arena has warmed up.
+void benchPool(std::ostream& out) {
+    constexpr int kLive = 64;
+    constexpr int kRounds = 20000;
+    std::array<TicTacToe*, kLive> games{};
+
+    auto start = Clock::now();
+    for (int r = 0; r < kRounds; ++r) {
+        for (auto& g : games) g = new TicTacToe();
+        for (auto& g : games) delete g;
+    }
+    report(out, "pool/new+delete", static_cast<std::uint64_t>(kRounds) * kLive, "games",
+           std::chrono::duration<double>(Clock::now() - start).count());
+
+    GamePool<TicTacToe> pool;
+    start = Clock::now();
+    for (int r = 0; r < kRounds; ++r) {
+        for (auto& g : games) g = pool.acquire();
+        for (auto& g : games) pool.release(g);
+    }
+    report(out, "pool/acquire+release", static_cast<std::uint64_t>(kRounds) * kLive, "games",
+           std::chrono::duration<double>(Clock::now() - start).count());
+
+    Mcts<QubicBoard> mcts(50, 12345);
+    Arena& arena = Arena::local();
+    for (int warm = 0; warm < 6; ++warm) mcts.chooseMove(qubicPosition(warm % 3)); // Let the arena reach its working size
+    const std::uint64_t before = arena.chunkAllocations();
+    constexpr int kMoves = 20;
+    start = Clock::now();
+    for (int m = 0; m < kMoves; ++m) mcts.chooseMove(qubicPosition(m % 3));
+    out << "pool/mcts arena: " << (arena.chunkAllocations() - before) << " chunk allocations in " << kMoves
+        << " moves, " << arena.bytesReserved() / 1024 << " KiB reserved\n";
+}
+
+// Scripted move stream: the old `stream >> char >> int` prompt path against
+// LineReader + MoveParser over the same file. Forms are limited to ones both can read.
+void benchParse(std::ostream& out) {
+    constexpr int kLines = 2000000;
+    static const char* forms[] = {"B 2", "b2", "A 1", "c3", "C 1", "a3"};
+    const std::string path = (std::filesystem::temp_directory_path() / "tictactoe-parse-bench.txt").string();
+    {
+        std::ofstream script(path, std::ios::binary);
+        for (int i = 0; i < kLines; ++i) script << forms[i % 6] << '\n';
+    }
+
+    std::uint64_t checksum = 0;
+    auto start = Clock::now();
+    {
+        std::ifstream in(path);
+        char rowChar;
+        int colNum;
+        while (in >> rowChar >> colNum) {
+            if (rowChar >= 'a' && rowChar <= 'z') rowChar = char(rowChar - 'a' + 'A'); // As the old prompt normalized
+            checksum += static_cast<std::uint64_t>(TicTacToe::rowIndexFromLabel(rowChar) * 3 + colNum - 1);
+        }
+    }
+    report(out, "parse/istream", kLines, "moves", std::chrono::duration<double>(Clock::now() - start).count());
+
+    std::uint64_t checksum2 = 0;
+    start = Clock::now();
+#if defined(_WIN32)
+    int fd = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+#endif
+    if (fd >= 0) {
+        LineReader reader(fd);
+        while (auto line = reader.next()) checksum2 += static_cast<std::uint64_t>(MoveParser::classic(*line).cell);
+#if defined(_WIN32)
+        _close(fd);
+#else
+        ::close(fd);
+#endif
+    }
+    report(out, "parse/linereader", kLines, "moves", std::chrono::duration<double>(Clock::now() - start).count());
+    if (checksum != checksum2) out << "parse: checksum mismatch (" << checksum << " vs " << checksum2 << ")\n";
+    std::remove(path.c_str());
+}
+
+// One game channel publishing Qubic-length rounds while four spectators
+// drain it on their own threads, then wire bytes per move against redrawing the board.
+void benchBroadcast(std::ostream& out) {
+    constexpr int kDeltas = 2000000;
+    constexpr int kSubscribers = 4;
+    auto channel = std::make_shared<GameChannel>(1, 64);
+    std::vector<std::uint64_t> lines(kSubscribers), bytes(kSubscribers), overruns(kSubscribers);
+    std::vector<std::thread> spectators;
+    for (int i = 0; i < kSubscribers; ++i) {
+        spectators.emplace_back([&, i] {
+            Subscriber sub(channel);
+            std::string wire;
+            while (!sub.finished()) {
+                std::size_t n = sub.poll(wire);
+                lines[i] += n;
+                bytes[i] += wire.size();
+                wire.clear();
+                if (!n) std::this_thread::yield();
+            }
+            overruns[i] = sub.overruns();
+        });
+    }
+
+    auto start = Clock::now();
+    for (int i = 0, cell = 0; i < kDeltas; ++i) {
+        if (cell == 64) {
+            channel->publishReset();
+            cell = 0;
+            std::this_thread::yield(); // Between rounds, as a live server would; lets spectators run on few cores
+        } else {
+            channel->publishMove(cell, (cell & 1) ? 'O' : 'X', GameState::RUNNING);
+            ++cell;
+        }
+    }
+    report(out, "broadcast/publish", kDeltas, "deltas", std::chrono::duration<double>(Clock::now() - start).count());
+    channel->close();
+    for (auto& t : spectators) t.join();
+    report(out, "broadcast/fan-out", lines[0] + lines[1] + lines[2] + lines[3], "lines",
+           std::chrono::duration<double>(Clock::now() - start).count());
+
+    Qubic game;
+    std::ostringstream board;
+    game.drawBoard(board);
+    std::uint64_t overrun = overruns[0] + overruns[1] + overruns[2] + overruns[3];
+    out << "broadcast/wire: " << std::fixed << std::setprecision(1)
+        << static_cast<double>(bytes[0]) / static_cast<double>(lines[0] ? lines[0] : 1) << " bytes per line vs "
+        << board.str().size() << " per redrawn Qubic board; " << overrun << " subscriber resyncs\n";
+    out.unsetf(std::ios::floatfield);
+}
+
+// Random 3x3 self-play on one thread: TicTacToe::computerMove one game at a time
+// against BatchEngine's lockstep lanes, with both X win rates as a sanity check.
+void benchBatch(std::ostream& out) {
+    constexpr std::uint64_t kGames = 2000000;
+    TicTacToe game;
+    std::uint64_t xWins = 0, moves = 0;
+    auto start = Clock::now();
+    for (std::uint64_t g = 0; g < kGames; ++g) {
+        game.resetGame();
+        for (; game.getState() == GameState::RUNNING; ++moves) game.computerMove();
+        xWins += game.getState() == GameState::HUMAN_WIN;
+    }
+    const double scalar = std::chrono::duration<double>(Clock::now() - start).count();
+    report(out, "batch/scalar", kGames, "games", scalar);
+
+    BatchEngine engine(4096, 12345);
+    start = Clock::now();
+    const BatchStats stats = engine.play(kGames);
+    const double batched = std::chrono::duration<double>(Clock::now() - start).count();
+    report(out, "batch/soa 4096 lanes", stats.games, "games", batched);
+    out << std::fixed << std::setprecision(1) << "batch: " << scalar / batched << "x; X wins " << 100.0 * static_cast<double>(xWins) / kGames
+        << "% vs " << 100.0 * static_cast<double>(stats.xWins) / static_cast<double>(stats.games) << "%, "
+        << static_cast<double>(moves) / kGames << " vs " << static_cast<double>(stats.moves) / static_cast<double>(stats.games)
+        << " moves per game\n";
+    out.unsetf(std::ios::floatfield);
+}
+
+void benchUltimate(std::ostream& out) {
+    UltimateMcts mcts(500, 12345);
+    UltimateBoard board;
+    auto start = Clock::now();
+    mcts.chooseMove(board);
+    report(out, "ultimate/mcts 500ms", mcts.lastIterations(), "iters",
+           std::chrono::duration<double>(Clock::now() - start).count());
+}
+} // namespace
+
+const char* Benchmark::suiteNames() {
+    return "qubic|threats|nn|pool|parse|broadcast|batch|ultimate|all";
+}
+
+bool Benchmark::run(const std::string& suite, std::ostream& out) {
+    bool all = suite == "all";
+    bool known = all;
+    if (all || suite == "qubic") { benchQubic(out); known = true; }
+    if (all || suite == "threats") { benchThreats(out); known = true; }
+    if (all || suite == "nn") { benchNn(out); known = true; }
+    if (all || suite == "pool") { benchPool(out); known = true; }
+    if (all || suite == "parse") { benchParse(out); known = true; }
+    if (all || suite == "broadcast") { benchBroadcast(out); known = true; }
+    if (all || suite == "batch") { benchBatch(out); known = true; }
+    if (all || suite == "ultimate") { benchUltimate(out); known = true; }
+    return known;
+}
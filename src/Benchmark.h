@@ -0,0 +1,11 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <iosfwd> // std::ostream forward declaration
+#include <string>
+
+// Fixed-workload throughput benchmarks (--bench SUITE). Each suite prints one
+// line per measurement: name, work done, wall time and rate.
+class Benchmark {
+public:
+    static bool run(const std::string& suite, std::ostream& out); // false if the suite name is unknown
+    static const char* suiteNames();                              // For usage text
+};
@@ -0,0 +1,31 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <cstdint> // Fixed-width mask types
+
+// Portable bit tricks for the bitboard variants.
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h> // _BitScanForward64
+#endif
+
+inline int popcount64(std::uint64_t v) { // Number of set bits
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(v);
+#else
+    int n = 0;
+    for (; v; v &= v - 1) ++n; // Portable fallback (MSVC ARM64 has no __popcnt64)
+    return n;
+#endif
+}
+
+inline int lowestBit64(std::uint64_t v) { // Index of the lowest set bit; v must be non-zero
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(v);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index;
+    _BitScanForward64(&index, v);
+    return static_cast<int>(index);
+#else
+    int i = 0;
+    while (!((v >> i) & 1)) ++i;
+    return i;
+#endif
+}
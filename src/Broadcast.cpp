@@ -0,0 +1,319 @@
+#include "Broadcast.h" // Broadcast ring, channel and subscriber declarations
+#include "AllocProfile.h" // Channels and the sender thread are charged to the broadcast tag
+#include <algorithm>   // std::find
+#include <map>
+#include <thread>      // std::this_thread::yield while a snapshot is being rewritten
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <fcntl.h>     // O_NONBLOCK
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>    // sockaddr_un
+#include <unistd.h>
+#endif
+
+namespace {
+void appendNumber(std::string& out, std::uint64_t v) {
+    char digits[20];
+    int n = 0;
+    do {
+        digits[n++] = static_cast<char>('0' + v % 10);
+        v /= 10;
+    } while (v);
+    while (n > 0) out.push_back(digits[--n]);
+}
+} // namespace
+
+std::uint64_t BoardDelta::pack() const {
+    return static_cast<std::uint64_t>(cell) | static_cast<std::uint64_t>(static_cast<unsigned char>(mark)) << 8 |
+           static_cast<std::uint64_t>(state) << 16 | static_cast<std::uint64_t>(ply) << 24;
+}
+
+BoardDelta BoardDelta::unpack(std::uint64_t bits) {
+    BoardDelta d;
+    d.cell = static_cast<std::uint8_t>(bits);
+    d.mark = static_cast<char>(bits >> 8);
+    d.state = static_cast<GameState>((bits >> 16) & 0xFF);
+    d.ply = static_cast<std::uint8_t>(bits >> 24);
+    return d;
+}
+
+// ── Ring ─────────────────────────────────────────────────────────────────
+
+std::uint64_t BroadcastRing::publish(const BoardDelta& delta) {
+    const std::uint64_t n = published.load(std::memory_order_relaxed) + 1;
+    Slot& s = slots[n & (kCapacity - 1)];
+    s.seq.store(0, std::memory_order_relaxed);            // Readers of the old entry will see it change
+    std::atomic_thread_fence(std::memory_order_release);
+    s.payload.store(delta.pack(), std::memory_order_relaxed);
+    s.seq.store(n, std::memory_order_release);
+    published.store(n, std::memory_order_release);
+    return n;
+}
+
+BroadcastRing::ReadStatus BroadcastRing::read(std::uint64_t seq, BoardDelta& out) const {
+    if (seq > head()) return ReadStatus::EMPTY;
+    const Slot& s = slots[seq & (kCapacity - 1)];
+    const std::uint64_t before = s.seq.load(std::memory_order_acquire);
+    if (before != seq) return before == 0 || before > seq ? ReadStatus::OVERRUN : ReadStatus::EMPTY;
+    const std::uint64_t bits = s.payload.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (s.seq.load(std::memory_order_relaxed) != seq) return ReadStatus::OVERRUN; // Rewritten under us
+    out = BoardDelta::unpack(bits);
+    return ReadStatus::OK;
+}
+
+// ── Channel ──────────────────────────────────────────────────────────────
+
+void GameChannel::publishMove(int cell, char mark, GameState after) {
+    const std::uint64_t bit = 1ULL << cell;
+    if (mark == 'X') x |= bit;
+    else o |= bit;
+    ++ply;
+    state = after;
+    BoardDelta d;
+    d.cell = static_cast<std::uint8_t>(cell);
+    d.mark = mark;
+    d.state = after;
+    d.ply = static_cast<std::uint8_t>(ply);
+    publish(d);
+}
+
+void GameChannel::publishReset() {
+    x = o = 0;
+    ply = 0;
+    state = GameState::RUNNING;
+    publish(BoardDelta{});
+}
+
+void GameChannel::publish(const BoardDelta& delta) {
+    const std::uint64_t seq = deltas.publish(delta);
+    if (seq - lastSnapshot >= kSnapshotEvery || delta.mark == 0 || delta.state != GameState::RUNNING) writeSnapshot(seq);
+}
+
+void GameChannel::writeSnapshot(std::uint64_t seq) {
+    const std::uint64_t v = snapVersion.load(std::memory_order_relaxed);
+    snapVersion.store(v + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    snapSeq.store(seq, std::memory_order_relaxed);
+    snapX.store(x, std::memory_order_relaxed);
+    snapO.store(o, std::memory_order_relaxed);
+    snapMeta.store(static_cast<std::uint64_t>(state) | static_cast<std::uint64_t>(ply) << 8, std::memory_order_relaxed);
+    snapVersion.store(v + 2, std::memory_order_release);
+    lastSnapshot = seq;
+}
+
+BoardSnapshot GameChannel::snapshot() const {
+    for (;;) {
+        const std::uint64_t v = snapVersion.load(std::memory_order_acquire);
+        if (v & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        BoardSnapshot s;
+        s.seq = snapSeq.load(std::memory_order_relaxed);
+        s.x = snapX.load(std::memory_order_relaxed);
+        s.o = snapO.load(std::memory_order_relaxed);
+        const std::uint64_t meta = snapMeta.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (snapVersion.load(std::memory_order_relaxed) != v) continue;
+        s.state = static_cast<GameState>(meta & 0xFF);
+        s.ply = static_cast<int>(meta >> 8);
+        return s;
+    }
+}
+
+// ── Subscriber ───────────────────────────────────────────────────────────
+
+void Subscriber::appendSnapshot(std::string& out) {
+    const BoardSnapshot s = source->snapshot();
+    out += "S ";
+    appendNumber(out, static_cast<std::uint64_t>(source->id()));
+    out += ' ';
+    appendNumber(out, s.seq);
+    out += ' ';
+    appendNumber(out, static_cast<std::uint64_t>(s.ply));
+    out += ' ';
+    appendNumber(out, static_cast<std::uint64_t>(s.state));
+    out += ' ';
+    for (int c = 0; c < source->cells(); ++c) out += (s.x >> c & 1) ? 'X' : (s.o >> c & 1) ? 'O' : '.';
+    out += '\n';
+    next = s.seq + 1;
+}
+
+std::size_t Subscriber::poll(std::string& out) {
+    if (done) return 0;
+    std::size_t lines = 0;
+    const bool closing = source->closed(); // Read first: once closed, everything published is visible below
+    if (next == 0) {
+        appendSnapshot(out);
+        ++lines;
+    }
+    for (;;) {
+        BoardDelta d;
+        const BroadcastRing::ReadStatus status = source->ring().read(next, d);
+        if (status == BroadcastRing::ReadStatus::EMPTY) break;
+        if (status == BroadcastRing::ReadStatus::OVERRUN) { // Fell a full ring behind: start over from the snapshot
+            ++resyncs;
+            appendSnapshot(out);
+            ++lines;
+            continue;
+        }
+        if (d.mark == 0) {
+            out += "R ";
+            appendNumber(out, static_cast<std::uint64_t>(source->id()));
+            out += ' ';
+            appendNumber(out, next);
+        } else {
+            out += "D ";
+            appendNumber(out, static_cast<std::uint64_t>(source->id()));
+            out += ' ';
+            appendNumber(out, next);
+            out += ' ';
+            appendNumber(out, d.cell);
+            out += ' ';
+            out += d.mark;
+            out += ' ';
+            appendNumber(out, static_cast<std::uint64_t>(d.state));
+        }
+        out += '\n';
+        ++next;
+        ++lines;
+    }
+    if (closing) {
+        out += "E ";
+        appendNumber(out, static_cast<std::uint64_t>(source->id()));
+        out += '\n';
+        ++lines;
+        done = true;
+    }
+    return lines;
+}
+
+// ── Hub ──────────────────────────────────────────────────────────────────
+
+std::shared_ptr<GameChannel> BroadcastHub::open(int cells) {
+    AllocScope scope(AllocTag::Broadcast);
+    std::lock_guard<std::mutex> lock(mutex);
+    channels.push_back(std::make_shared<GameChannel>(nextId++, cells));
+    return channels.back();
+}
+
+void BroadcastHub::retire(const std::shared_ptr<GameChannel>& channel) {
+    channel->close();
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = std::find(channels.begin(), channels.end(), channel);
+    if (it != channels.end()) channels.erase(it);
+}
+
+std::shared_ptr<GameChannel> BroadcastHub::find(int id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& c : channels)
+        if (c->id() == id) return c;
+    return nullptr;
+}
+
+std::vector<std::shared_ptr<GameChannel>> BroadcastHub::live() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return channels;
+}
+
+// ── Spectator server ─────────────────────────────────────────────────────
+
+#if !defined(_WIN32)
+
+SpectatorServer::~SpectatorServer() {
+    stopping.store(true, std::memory_order_relaxed);
+    if (sender.joinable()) sender.join();
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        ::unlink(path.c_str());
+    }
+}
+
+bool SpectatorServer::start(const char* socketPath) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    path = socketPath;
+    if (path.size() >= sizeof addr.sun_path) return false;
+    path.copy(addr.sun_path, path.size());
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ::unlink(socketPath);
+    if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) < 0 || ::listen(listenFd, 64) < 0) {
+        if (listenFd >= 0) ::close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    ::fcntl(listenFd, F_SETFL, ::fcntl(listenFd, F_GETFL) | O_NONBLOCK);
+    sender = std::thread([this] { run(); });
+    return true;
+}
+
+void SpectatorServer::run() {
+    AllocScope scope(AllocTag::Broadcast); // Everything on the sender thread
+    struct Watcher {
+        int fd;
+        std::map<int, Subscriber> games; // By channel id
+        std::string pending;             // Lines not yet accepted by the socket
+        std::size_t sent = 0;
+    };
+    std::vector<Watcher> watchers;
+    std::vector<pollfd> fds;
+    char scratch[256];
+
+    while (!stopping.load(std::memory_order_relaxed)) {
+        for (int fd; (fd = ::accept(listenFd, nullptr, nullptr)) >= 0;) {
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+            watchers.push_back({fd, {}, {}, 0});
+        }
+
+        const auto live = watchers.empty() ? std::vector<std::shared_ptr<GameChannel>>{} : hub.live();
+        for (auto& w : watchers) {
+            if (w.sent < w.pending.size()) continue; // Still flushing: leave its cursors where they are
+            w.pending.clear();
+            w.sent = 0;
+            for (const auto& c : live)
+                if (!w.games.count(c->id())) w.games.emplace(c->id(), Subscriber(c));
+            for (auto it = w.games.begin(); it != w.games.end();) {
+                it->second.poll(w.pending);
+                it = it->second.finished() ? w.games.erase(it) : std::next(it);
+            }
+        }
+
+        fds.clear();
+        fds.push_back({listenFd, POLLIN, 0});
+        for (const auto& w : watchers)
+            fds.push_back({w.fd, static_cast<short>(POLLIN | (w.sent < w.pending.size() ? POLLOUT : 0)), 0});
+        if (::poll(fds.data(), static_cast<nfds_t>(fds.size()), 20) < 0 && errno != EINTR) break; // 20 ms: new moves are picked up by polling
+
+        for (std::size_t i = 0; i < watchers.size();) {
+            Watcher& w = watchers[i];
+            const short events = fds[i + 1].revents;
+            bool gone = (events & (POLLERR | POLLHUP)) != 0;
+            if (!gone && (events & POLLIN)) gone = ::read(w.fd, scratch, sizeof scratch) <= 0; // Watchers only listen
+            if (!gone && w.sent < w.pending.size()) {
+                ssize_t n = ::write(w.fd, w.pending.data() + w.sent, w.pending.size() - w.sent);
+                if (n > 0) w.sent += static_cast<std::size_t>(n);
+                else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) gone = true;
+            }
+            if (gone) {
+                ::close(w.fd);
+                fds.erase(fds.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+                watchers.erase(watchers.begin() + static_cast<std::ptrdiff_t>(i));
+                continue;
+            }
+            ++i;
+        }
+    }
+    for (auto& w : watchers) ::close(w.fd);
+}
+
+#else // Windows: no Unix sockets here
+
+SpectatorServer::~SpectatorServer() = default;
+bool SpectatorServer::start(const char*) { return false; }
+void SpectatorServer::run() {}
+
+#endif
@@ -0,0 +1,167 @@
+#pragma once // Ensure the header is included only once during compilation
+#include "Driver.h" // GameState
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>   // Channels are shared between the game and its spectators
+#include <mutex>
+#include <string>
+#include <thread>   // SpectatorServer's sender thread
+#include <vector>
+
+// Live-game broadcast for spectators.
+//
+// A game publishes one 8-byte BoardDelta per move into its GameChannel.
+// The channel is a single-producer, many-consumer ring. Readers never block
+// the producer, and the producer never waits for readers. Each Subscriber
+// keeps its own cursor and catches up at its own pace. If a subscriber falls
+// more than a ring's length behind, it sees an overrun and resyncs from the
+// channel's snapshot. The producer refreshes that snapshot every few moves
+// through a seqlock, and late joiners start from it too.
+//
+// On the wire, a spectator gets one short text line per move instead of a
+// redrawn board:
+//   S <game> <seq> <ply> <state> <cells>    snapshot; cells is '.', 'X', 'O' per cell
+//   D <game> <seq> <cell> <mark> <state>    move delta; state is the GameState after it
+//   R <game> <seq>                          board cleared for a new round
+//   E <game>                                game closed
+//
+// SpectatorServer pushes these lines to every watcher on a Unix socket.
+
+struct BoardDelta {
+    std::uint8_t cell = 0;   // 0..63
+    char mark = 0;           // 'X' or 'O'; 0 marks a reset
+    GameState state = GameState::RUNNING;
+    std::uint8_t ply = 0;    // Marks on the board after this delta
+
+    std::uint64_t pack() const;
+    static BoardDelta unpack(std::uint64_t bits);
+};
+
+struct BoardSnapshot {
+    std::uint64_t seq = 0;   // Last delta folded in; a subscriber continues from seq + 1
+    std::uint64_t x = 0;     // Cell masks
+    std::uint64_t o = 0;
+    GameState state = GameState::RUNNING;
+    int ply = 0;
+};
+
+// Fixed-size SPMC ring. Each slot carries its sequence number; it is cleared
+// before the payload is rewritten and set after, so a reader that sees the
+// same number on both sides of its copy has a consistent delta.
+class BroadcastRing {
+public:
+    static constexpr std::size_t kCapacity = 1024; // Power of two
+
+    enum class ReadStatus { OK, EMPTY, OVERRUN };
+
+    std::uint64_t publish(const BoardDelta& delta);               // Producer only; returns its seq (from 1)
+    ReadStatus read(std::uint64_t seq, BoardDelta& out) const;    // Any thread
+    std::uint64_t head() const { return published.load(std::memory_order_acquire); }
+
+private:
+    struct alignas(64) Slot { // One cache line each: neighbouring slots do not false-share
+        std::atomic<std::uint64_t> seq{0};
+        std::atomic<std::uint64_t> payload{0};
+    };
+    std::array<Slot, kCapacity> slots;
+    std::atomic<std::uint64_t> published{0};
+};
+
+// One game's ring plus its seqlocked snapshot.
+class GameChannel {
+public:
+    static constexpr int kSnapshotEvery = 16; // Deltas between snapshot refreshes
+
+    GameChannel(int id, int cells) : gameId(id), cellCount(cells) {}
+
+    // Producer side (the thread running the game)
+    void publishMove(int cell, char mark, GameState state);
+    void publishReset();
+    void close() { isClosed.store(true, std::memory_order_release); }
+
+    // Reader side
+    int id() const { return gameId; }
+    int cells() const { return cellCount; }
+    bool closed() const { return isClosed.load(std::memory_order_acquire); }
+    BoardSnapshot snapshot() const;
+    const BroadcastRing& ring() const { return deltas; }
+
+private:
+    const int gameId;
+    const int cellCount;
+    BroadcastRing deltas;
+    std::atomic<bool> isClosed{false};
+
+    // Producer-private board mirror
+    std::uint64_t x = 0, o = 0;
+    int ply = 0;
+    GameState state = GameState::RUNNING;
+    std::uint64_t lastSnapshot = 0;
+
+    // Seqlock: odd while the producer rewrites the fields below
+    std::atomic<std::uint64_t> snapVersion{0};
+    std::atomic<std::uint64_t> snapSeq{0}, snapX{0}, snapO{0}, snapMeta{0};
+
+    void publish(const BoardDelta& delta);
+    void writeSnapshot(std::uint64_t seq);
+};
+
+// A spectator's cursor into one channel.
+class Subscriber {
+public:
+    explicit Subscriber(std::shared_ptr<const GameChannel> channel) : source(std::move(channel)) {}
+
+    // Appends wire lines for everything new; returns the number of lines. A
+    // snapshot comes first on the first call and after an overrun.
+    std::size_t poll(std::string& out);
+    bool finished() const { return done; } // Channel closed and fully drained
+    std::uint64_t overruns() const { return resyncs; }
+
+private:
+    std::shared_ptr<const GameChannel> source;
+    std::uint64_t next = 0;  // Next seq to read; 0 = needs a snapshot
+    std::uint64_t resyncs = 0;
+    bool done = false;
+
+    void appendSnapshot(std::string& out);
+};
+
+// Registry of live channels; locked only when games start, end or are listed.
+class BroadcastHub {
+public:
+    std::shared_ptr<GameChannel> open(int cells);
+    void retire(const std::shared_ptr<GameChannel>& channel); // Closes it and drops it from the listing
+    std::shared_ptr<GameChannel> find(int id) const;
+    std::vector<std::shared_ptr<GameChannel>> live() const;
+
+private:
+    mutable std::mutex mutex;
+    std::vector<std::shared_ptr<GameChannel>> channels;
+    int nextId = 1;
+};
+
+// Accepts watchers on a Unix socket and pushes every live game to each of
+// them. One sender thread serves all watchers with non-blocking writes.
+// A watcher whose socket is full simply stops pulling from the rings, and
+// an overrun resyncs it from a snapshot later; the games never wait for it.
+// POSIX only: start() fails on Windows.
+class SpectatorServer {
+public:
+    explicit SpectatorServer(const BroadcastHub& hub) : hub(hub) {}
+    ~SpectatorServer();
+    SpectatorServer(const SpectatorServer&) = delete;
+    SpectatorServer& operator=(const SpectatorServer&) = delete;
+
+    bool start(const char* socketPath);
+
+private:
+    const BroadcastHub& hub;
+    std::string path;
+    int listenFd = -1;
+    std::atomic<bool> stopping{false};
+    std::thread sender;
+
+    void run();
+};
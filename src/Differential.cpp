@@ -0,0 +1,408 @@
+#include "Differential.h"   // Differential checker declarations
+#include "AdaptiveAgent.h"  // Perfect-play agent under test
+#include "Bits.h"           // popcount64 / lowestBit64
+#include "Driver.h"         // TicTacToe under test
+#include "QubicBoard.h"     // Qubic bitboard under test
+#include "Rules.h"          // Mask rules and evaluatePosition under test
+#include "Solver.h"         // Solved table under test
+#include "tictactoe/engine.h" // C API under test
+#include <algorithm>        // std::max
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <mutex>            // First-failure slot shared by the workers
+#include <ostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+// ── Reference implementations ────────────────────────────────────────────
+
+// The original char-array rules, frozen here as the oracle. Do not optimize.
+struct ReferenceBoard {
+    char board[3][3];
+    char currentPlayer;
+
+    void reset() {
+        for (auto& row : board)
+            for (char& cell : row) cell = ' ';
+        currentPlayer = 'X';
+    }
+
+    bool isAvailable(int row, int col) const {
+        if (row < 0 || row > 2 || col < 0 || col > 2) return false;
+        return board[row][col] == ' ';
+    }
+
+    bool placeMark(int row, int col) {
+        if (!isAvailable(row, col)) return false;
+        board[row][col] = currentPlayer;
+        return true;
+    }
+
+    void switchTurn() { currentPlayer = (currentPlayer == 'X') ? 'O' : 'X'; }
+
+    GameState evaluateBoard() const {
+        auto threeEqual = [&](char a, char b, char c, char who) {
+            return (a == who && b == who && c == who);
+        };
+
+        for (int i = 0; i < 3; ++i) {
+            if (threeEqual(board[i][0], board[i][1], board[i][2], 'X')) return GameState::HUMAN_WIN;
+            if (threeEqual(board[i][0], board[i][1], board[i][2], 'O')) return GameState::CPU_WIN;
+
+            if (threeEqual(board[0][i], board[1][i], board[2][i], 'X')) return GameState::HUMAN_WIN;
+            if (threeEqual(board[0][i], board[1][i], board[2][i], 'O')) return GameState::CPU_WIN;
+        }
+
+        if (threeEqual(board[0][0], board[1][1], board[2][2], 'X')) return GameState::HUMAN_WIN;
+        if (threeEqual(board[0][0], board[1][1], board[2][2], 'O')) return GameState::CPU_WIN;
+        if (threeEqual(board[0][2], board[1][1], board[2][0], 'X')) return GameState::HUMAN_WIN;
+        if (threeEqual(board[0][2], board[1][1], board[2][0], 'O')) return GameState::CPU_WIN;
+
+        for (const auto& row : board)
+            for (char cell : row)
+                if (cell == ' ') return GameState::RUNNING;
+
+        return GameState::TIE;
+    }
+
+    int key() const { // Base-3, cell n weighted 3^n
+        int k = 0;
+        for (int i = 8; i >= 0; --i) {
+            char c = board[i / 3][i % 3];
+            k = k * 3 + (c == 'X' ? 1 : c == 'O' ? 2 : 0);
+        }
+        return k;
+    }
+};
+
+// Plain memoized minimax over ReferenceBoard, in Solver's value convention.
+int referenceNegamax(ReferenceBoard& b, int marks, std::array<std::int8_t, 19683>& memo) {
+    std::int8_t& slot = memo[static_cast<std::size_t>(b.key())];
+    if (slot != Solver::kUnreachable) return slot;
+    int value;
+    GameState s = b.evaluateBoard();
+    if (s == GameState::HUMAN_WIN || s == GameState::CPU_WIN) value = -(10 - marks); // The previous mover won
+    else if (s == GameState::TIE) value = 0;
+    else {
+        value = -100;
+        for (int r = 0; r < 3; ++r)
+            for (int c = 0; c < 3; ++c) {
+                if (!b.placeMark(r, c)) continue;
+                b.switchTurn();
+                value = std::max(value, -referenceNegamax(b, marks + 1, memo));
+                b.switchTurn();
+                b.board[r][c] = ' ';
+            }
+    }
+    slot = static_cast<std::int8_t>(value);
+    return value;
+}
+
+const std::array<std::int8_t, 19683>& referenceValues() {
+    static const std::array<std::int8_t, 19683> values = [] {
+        std::array<std::int8_t, 19683> memo;
+        memo.fill(Solver::kUnreachable);
+        ReferenceBoard b;
+        b.reset();
+        referenceNegamax(b, 0, memo);
+        return memo;
+    }();
+    return values;
+}
+
+// Qubic lines found by walking the 13 directions from every cell, independent of Rules.h.
+const std::vector<std::array<int, 4>>& referenceCubeLines() {
+    static const std::vector<std::array<int, 4>> lines = [] {
+        std::vector<std::array<int, 4>> out;
+        for (int dl = -1; dl <= 1; ++dl)
+            for (int dr = -1; dr <= 1; ++dr)
+                for (int dc = -1; dc <= 1; ++dc) {
+                    int first = dl != 0 ? dl : dr != 0 ? dr : dc;
+                    if (first <= 0) continue; // Skip the null vector and one of each opposite pair
+                    for (int start = 0; start < 64; ++start) {
+                        int l = start / 16, r = (start / 4) % 4, c = start % 4;
+                        int el = l + 3 * dl, er = r + 3 * dr, ec = c + 3 * dc;
+                        if (el < 0 || el > 3 || er < 0 || er > 3 || ec < 0 || ec > 3) continue;
+                        std::array<int, 4> line;
+                        for (int k = 0; k < 4; ++k) line[k] = (l + k * dl) * 16 + (r + k * dr) * 4 + (c + k * dc);
+                        out.push_back(line);
+                    }
+                }
+        return out;
+    }();
+    return lines;
+}
+
+struct ReferenceCube {
+    char cells[64];
+
+    GameState evaluate() const {
+        bool full = true;
+        for (char c : cells) full &= c != ' ';
+        for (const auto& line : referenceCubeLines()) {
+            char a = cells[line[0]];
+            if (a != ' ' && a == cells[line[1]] && a == cells[line[2]] && a == cells[line[3]])
+                return a == 'X' ? GameState::HUMAN_WIN : GameState::CPU_WIN;
+        }
+        return full ? GameState::TIE : GameState::RUNNING;
+    }
+
+    std::uint64_t winningCells(char who) const { // Empty cells completing a line of three
+        std::uint64_t out = 0;
+        for (const auto& line : referenceCubeLines()) {
+            int mine = 0, empty = -1;
+            for (int cell : line) {
+                if (cells[cell] == who) ++mine;
+                else if (cells[cell] == ' ') empty = cell;
+            }
+            if (mine == 3 && empty >= 0) out |= 1ULL << empty;
+        }
+        return out;
+    }
+};
+
+// ── Harness helpers ──────────────────────────────────────────────────────
+
+std::string describe(const char* variant, std::size_t step, int cell, const std::string& what,
+                     const std::uint8_t* data, std::size_t size) {
+    std::ostringstream s;
+    s << variant << " byte " << step << " (cell " << cell << "): " << what << "; input:";
+    s << std::hex << std::setfill('0');
+    for (std::size_t i = 0; i < size; ++i) s << ' ' << std::setw(2) << static_cast<int>(data[i]);
+    return s.str();
+}
+
+std::string mismatch(const char* who, GameState got, GameState expected) {
+    std::ostringstream s;
+    s << who << " says " << static_cast<int>(got) << ", reference says " << static_cast<int>(expected);
+    return s.str();
+}
+
+// n-th set bit (mod popcount) of a non-empty mask
+int nthBit(std::uint64_t mask, int n) {
+    n %= popcount64(mask);
+    while (n-- > 0) mask &= mask - 1;
+    return lowestBit64(mask);
+}
+
+// Byte -> cell: low bits pick among the empty cells; the top bit asks for an occupied one.
+int decodeCell(std::uint8_t byte, std::uint64_t empty, std::uint64_t occupied) {
+    if ((byte & 0x80) && occupied) return nthBit(occupied, byte & 0x7F);
+    if (empty) return nthBit(empty, byte & 0x7F);
+    return nthBit(occupied, byte & 0x7F);
+}
+
+// Per-thread objects under test, reused across games
+struct ClassicHarness {
+    TicTacToe game;
+    AdaptiveAgent perfect;
+    ttt_game* api = ttt_create();
+    ClassicHarness() { AdaptiveAgent::prepare(); }
+    ~ClassicHarness() { ttt_destroy(api); }
+};
+
+std::uint64_t nextRandom(std::uint64_t& s) { // xorshift64*
+    s ^= s >> 12;
+    s ^= s << 25;
+    s ^= s >> 27;
+    return s * 2685821657736338717ULL;
+}
+} // namespace
+
+bool Differential::checkClassic(const std::uint8_t* data, std::size_t size, std::string* failure) {
+    thread_local ClassicHarness h;
+    const auto& values = referenceValues();
+    ReferenceBoard ref;
+    ref.reset();
+    h.game.resetGame();
+    ttt_reset(h.api);
+    std::uint16_t x = 0, o = 0;
+    GameState expected = GameState::RUNNING;
+
+    auto fail = [&](std::size_t step, int cell, const std::string& what) {
+        if (failure) *failure = describe("classic", step, cell, what, data, size);
+        return false;
+    };
+
+    for (std::size_t step = 0; step < size; ++step) {
+        const std::uint16_t occupied = static_cast<std::uint16_t>(x | o);
+        const int cell = decodeCell(data[step], TicTacToe::kFullMask & ~occupied, occupied);
+        const int row = cell / 3, col = cell % 3;
+
+        if (expected != GameState::RUNNING) { // Game over: the C API must refuse (TicTacToe is driven through its primitives)
+            if (ttt_make_move(h.api, cell) != TTT_ERR_FINISHED) return fail(step, cell, "C API accepted a move after the end");
+            continue;
+        }
+
+        const bool legal = ref.isAvailable(row, col);
+        if (h.game.isAvailable(row, col) != legal) return fail(step, cell, "TicTacToe::isAvailable(int,int) disagrees");
+        if (h.game.isAvailable(static_cast<char>('A' + row), col + 1) != legal)
+            return fail(step, cell, "TicTacToe::isAvailable(char,int) disagrees");
+
+        const char mover = ref.currentPlayer;
+        const bool refPlaced = ref.placeMark(row, col);
+        const bool gamePlaced = h.game.placeMark(row, col);
+        const int apiRc = ttt_make_move(h.api, cell);
+        if (gamePlaced != refPlaced) return fail(step, cell, "TicTacToe::placeMark disagrees on legality");
+        if (apiRc != (refPlaced ? TTT_OK : TTT_ERR_OCCUPIED)) return fail(step, cell, "ttt_make_move returned " + std::to_string(apiRc));
+        if (!refPlaced) continue;
+
+        const std::uint16_t bit = static_cast<std::uint16_t>(1u << cell);
+        if (mover == 'X') x = static_cast<std::uint16_t>(x | bit);
+        else o = static_cast<std::uint16_t>(o | bit);
+        const std::uint16_t mine = mover == 'X' ? x : o;
+
+        expected = ref.evaluateBoard();
+        GameState got = h.game.evaluateBoard();
+        if (got != expected) return fail(step, cell, mismatch("TicTacToe::evaluateBoard", got, expected));
+        got = Rules<ClassicGeometry>::evaluate(x, o);
+        if (got != expected) return fail(step, cell, mismatch("Rules::evaluate", got, expected));
+        got = Rules<ClassicGeometry>::afterMove(mover, mine, static_cast<std::uint16_t>(x | o), cell);
+        if (got != expected) return fail(step, cell, mismatch("Rules::afterMove", got, expected));
+        got = evaluatePosition(BoardGeometry::CLASSIC_3X3, x, o);
+        if (got != expected) return fail(step, cell, mismatch("evaluatePosition", got, expected));
+        if (TicTacToe::hasLine(mine) != (expected == GameState::HUMAN_WIN || expected == GameState::CPU_WIN))
+            return fail(step, cell, "TicTacToe::hasLine disagrees");
+
+        got = static_cast<GameState>(ttt_get_state(h.api));
+        if (got != expected) return fail(step, cell, mismatch("ttt_get_state", got, expected));
+        const ttt_position position = ttt_get_position(h.api);
+        if (position.x != x || position.o != o) return fail(step, cell, "ttt_get_position disagrees");
+        ttt_result result;
+        if (ttt_evaluate_batch(&position, &result, 1) != 1) return fail(step, cell, "ttt_evaluate_batch rejected the position");
+        if (static_cast<GameState>(result.state) != expected)
+            return fail(step, cell, mismatch("ttt_evaluate_batch", static_cast<GameState>(result.state), expected));
+
+        if (expected == GameState::RUNNING) {
+            ref.switchTurn();
+            h.game.switchTurn();
+            if (ttt_side_to_move(h.api) != ref.currentPlayer) return fail(step, cell, "ttt_side_to_move disagrees");
+        }
+
+        // Solved-table AI against the reference minimax
+        const int value = values[static_cast<std::size_t>(ref.key())];
+        if (!Solver::isValid(x, o)) return fail(step, cell, "Solver::isValid rejects a legal position");
+        if (Solver::value(x, o) != value)
+            return fail(step, cell, "Solver::value " + std::to_string(Solver::value(x, o)) + ", reference " + std::to_string(value));
+        if (result.value != value) return fail(step, cell, "ttt_evaluate_batch value disagrees");
+        if (expected != GameState::RUNNING) continue;
+        const int best = Solver::bestMove(x, o);
+        if (best < 0 || Solver::moveValue(x, o, best) != value) return fail(step, cell, "Solver::bestMove is not optimal");
+        if (ttt_best_move(h.api) != best) return fail(step, cell, "ttt_best_move disagrees with Solver::bestMove");
+        std::array<int, 9> all;
+        Solver::analyze(x, o, all);
+        for (int c = 0; c < 9; ++c)
+            if (all[static_cast<std::size_t>(c)] != Solver::moveValue(x, o, c))
+                return fail(step, cell, "Solver::analyze disagrees with moveValue at cell " + std::to_string(c));
+        const int agentMove = h.perfect.chooseMove(x, o, true);
+        if (agentMove < 0 || ((x | o) >> agentMove & 1) || Solver::moveValue(x, o, agentMove) != value)
+            return fail(step, cell, "perfect AdaptiveAgent move is not optimal");
+    }
+    return true;
+}
+
+bool Differential::checkQubic(const std::uint8_t* data, std::size_t size, std::string* failure) {
+    ReferenceCube ref;
+    for (char& c : ref.cells) c = ' ';
+    QubicBoard board;
+    char mover = 'X';
+    GameState expected = GameState::RUNNING;
+
+    auto fail = [&](std::size_t step, int cell, const std::string& what) {
+        if (failure) *failure = describe("qubic", step, cell, what, data, size);
+        return false;
+    };
+
+    for (std::size_t step = 0; step < size; ++step) {
+        const std::uint64_t occupied = board.occupied();
+        const int cell = decodeCell(data[step], ~occupied, occupied);
+
+        if (expected != GameState::RUNNING) {
+            if (board.play(cell)) return fail(step, cell, "QubicBoard::play accepted a move after the end");
+            continue;
+        }
+
+        const bool legal = ref.cells[cell] == ' ';
+        if (board.isLegal(cell) != legal) return fail(step, cell, "QubicBoard::isLegal disagrees");
+        if (board.play(cell) != legal) return fail(step, cell, "QubicBoard::play disagrees on legality");
+        if (!legal) continue;
+
+        ref.cells[cell] = mover;
+        expected = ref.evaluate();
+        GameState got = board.state();
+        if (got != expected) return fail(step, cell, mismatch("QubicBoard::state", got, expected));
+        got = evaluatePosition(BoardGeometry::CUBE_4X4X4, board.marks('X'), board.marks('O'));
+        if (got != expected) return fail(step, cell, mismatch("evaluatePosition", got, expected));
+        if (board.cellAt(cell) != mover) return fail(step, cell, "QubicBoard::cellAt disagrees");
+
+        if (expected != GameState::RUNNING) continue;
+        mover = mover == 'X' ? 'O' : 'X';
+        if (board.sideToMove() != mover) return fail(step, cell, "QubicBoard::sideToMove disagrees");
+        if (board.winningCells('X') != ref.winningCells('X') || board.winningCells('O') != ref.winningCells('O'))
+            return fail(step, cell, "QubicBoard::winningCells disagrees");
+    }
+    return true;
+}
+
+DifferentialStats Differential::run(long long games, int threads, std::uint64_t seed) {
+    if (threads <= 0) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    if (games < threads) threads = static_cast<int>(std::max(1LL, games));
+    referenceValues();   // Build the shared oracles before the workers race for them
+    referenceCubeLines();
+
+    std::vector<DifferentialStats> partial(static_cast<size_t>(threads));
+    std::mutex failureMutex;
+    std::string firstFailure;
+
+    auto worker = [&](int id) {
+        long long share = games / threads + (id < games % threads ? 1 : 0);
+        DifferentialStats& s = partial[static_cast<size_t>(id)];
+        std::uint64_t rng = seed * 0x9E3779B97F4A7C15ULL + static_cast<std::uint64_t>(id) + 1;
+        std::uint8_t bytes[96];
+        std::string failure;
+        for (long long g = 0; g < share; ++g) {
+            const bool qubic = (g & 7) == 7; // Qubic games are ~50x longer; keep them to one in eight
+            const std::size_t size = qubic ? 72 + nextRandom(rng) % 24 : 9 + nextRandom(rng) % 6;
+            for (std::size_t i = 0; i < size; ++i) {
+                std::uint64_t r = nextRandom(rng);
+                bytes[i] = static_cast<std::uint8_t>((r & 0x7F) | ((r >> 8) % 8 == 0 ? 0x80 : 0)); // 1 in 8 illegal
+            }
+            const bool ok = qubic ? checkQubic(bytes, size, &failure) : checkClassic(bytes, size, &failure);
+            ++s.games;
+            s.moves += static_cast<long long>(size);
+            if (!ok) {
+                ++s.divergences;
+                std::lock_guard<std::mutex> lock(failureMutex);
+                if (firstFailure.empty()) firstFailure = failure;
+            }
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+
+    DifferentialStats total;
+    for (const auto& s : partial) {
+        total.games += s.games;
+        total.moves += s.moves;
+        total.divergences += s.divergences;
+    }
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    total.firstFailure = firstFailure;
+    return total;
+}
+
+void Differential::printSummary(const DifferentialStats& stats, std::ostream& out) {
+    double perMinute = stats.seconds > 0 ? static_cast<double>(stats.games) * 60.0 / stats.seconds : 0.0;
+    out << "Checked " << stats.games << " games (" << stats.moves << " moves) in " << std::fixed << std::setprecision(3)
+        << stats.seconds << " s (" << std::setprecision(0) << perMinute << " games/min)\n";
+    out.unsetf(std::ios::floatfield);
+    out << "Divergences: " << stats.divergences << "\n";
+    if (!stats.firstFailure.empty()) out << "First: " << stats.firstFailure << "\n";
+}
@@ -0,0 +1,42 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd> // std::ostream forward declaration
+#include <string>
+
+// Totals from a differential run (--fuzz).
+struct DifferentialStats {
+    long long games = 0;       // Random games replayed, both variants together
+    long long moves = 0;       // Move attempts, including deliberately illegal ones
+    long long divergences = 0; // Games where some implementation disagreed with the reference
+    double seconds = 0.0;
+    std::string firstFailure;  // Description and input bytes of the first divergence
+};
+
+// Differential checker for the rules and the solved-table AI.
+//
+// A byte string is decoded into a move sequence. Each byte picks one of the
+// empty cells, or, when its top bit is set, an occupied cell, which every
+// implementation must reject. The sequence is then replayed in lockstep
+// through a plain char-array reference and every optimized implementation.
+// The reference is kept here as a frozen copy of the original
+// TicTacToe::evaluateBoard / placeMark. After each move, all of them must
+// agree on legality, state and side to move:
+//
+//   classic: TicTacToe (placeMark/evaluateBoard), Rules<ClassicGeometry>
+//            evaluate and incremental afterMove, evaluatePosition, the C API
+//            (ttt_make_move, ttt_evaluate_batch), and Solver / the perfect
+//            AdaptiveAgent, checked against a reference minimax
+//   qubic:   QubicBoard (incremental bitboard play, winningCells) against
+//            a cube whose lines are enumerated by walking directions
+//
+// The same entry points back the libFuzzer target (fuzz/RulesFuzzer.cpp).
+class Differential {
+public:
+    static bool checkClassic(const std::uint8_t* data, std::size_t size, std::string* failure);
+    static bool checkQubic(const std::uint8_t* data, std::size_t size, std::string* failure);
+
+    // Random byte strings through both checkers on `threads` workers (<= 0: hardware concurrency)
+    static DifferentialStats run(long long games, int threads, std::uint64_t seed);
+    static void printSummary(const DifferentialStats& stats, std::ostream& out);
+};
@@ -1,5 +1,7 @@
 #pragma once // Ensures the header is included only once during compilation
-#include <array> // std::array for the 3x3 board
+#include <cstdint> // std::uint16_t cell masks
+#include <iosfwd> // std::ostream for the output overloads
+#include "AdaptiveAgent.h" // Difficulty levels and the solved-table opponent
 
 // High-level state of a single round of Tic-Tac-Toe.
 enum class GameState {
@@ -9,33 +11,57 @@ enum class GameState {
     TIE         // The game ended in a tie
 };
 
+// Which game the interface and batch modes run.
+enum class Variant {
+    CLASSIC,    // The original 3x3 board (TicTacToe)
+    ULTIMATE,   // Nine 3x3 sub-boards with the send rule (UltimateBoard)
+    QUBIC       // 4x4x4 cube, four in a row (Qubic)
+};
+
 // The TicTacToe class encapsulates board data, rules, and round/score logic.
 // \n// Public API now supports human-friendly coordinates: ROW = 'A'|'B'|'C', COL = 1|2|3.
 // Internally, the board still uses 0-based indices (0..2). Conversions are handled
 // by private helper functions declared below.
 class TicTacToe {
 private:
-    std::array<std::array<char, 3>, 3> board{}; // 3x3 board holding 'X', 'O', or ' ' (space) for empty
+    std::uint16_t xMask = 0;                    // Cells holding 'X' (bit row*3+col, as in the mask rules below)
+    std::uint16_t oMask = 0;                    // Cells holding 'O'
     GameState state = GameState::RUNNING;       // Current state of the game (RUNNING, HUMAN_WIN, etc.)
-    char currentPlayer = 'X';                   // Current player: 'X' for human, 'O' for CPU
+    bool xToMove = true;                        // 'X' (human) starts; playerMove/computerMove play whoever is to move
     int scoreHuman = 0;                         // Accumulated score for the human player
     int scoreCPU   = 0;                         // Accumulated score for the CPU player
+    Difficulty difficulty = Difficulty::RANDOM; // How computerMove picks its cell
+    AdaptiveAgent opponent;                     // Solved-table agent for ADAPTIVE / PERFECT
+    std::uint64_t rng;                          // xorshift64 state for RANDOM moves (time-seeded unless seed() is called)
+
+    template <char Side> void play(int cell);   // Mark an empty cell and take the state from that cell's lines only
+    void play(int cell);                        // play<'X'> or play<'O'> for the side to move
+    char mark(int cell) const;                  // 'X', 'O' or ' ' for drawing
 
 public:
     // Public helpers so UI code can convert labels
     static int rowIndexFromLabel(char rowLabel);   // 'A'/'a'->0, 'B'/'b'->1, 'C'/'c'->2; returns -1 if invalid
     static int colIndexFromLabel(int colLabel);    // 1->0, 2->1, 3->2; returns -1 if invalid
 
+    // Mask form of the rules, shared with variants built from 3x3 boards (e.g. Ultimate).
+    // Cell (row, col) is bit row*3+col of a 9-bit mask; the line tables live in Rules.h.
+    static constexpr std::uint16_t kFullMask = 0x1FF;
+    static bool hasLine(std::uint16_t cells);   // True if the mask contains a full row, column or diagonal
+
     TicTacToe();                                // Constructor to initialize the game
 
     // Round lifecycle
     void resetGame();                           // Reset the board, set state to RUNNING, and set human as starter
+    void resetSession();                        // Also zero the scores and the opponent model (a recycled game's new player)
     void drawBoard() const;                     // Display the board with headers: columns 1..3 and rows A..C
+    void drawBoard(std::ostream& out) const;    // Same, to any stream (async sessions render per connection)
+    void drawAnalysis(std::ostream& out) const; // Board with each empty cell's value for the side to move (coach mode)
 
     // Core rules (internal 0-based coordinates)
     bool placeMark(int row, int col);           // Attempt to place the current player's mark at (row, col)
     void playerMove(int row, int col);          // Process a human player's move at (row, col)
     bool isAvailable(int row, int col) const;   // Check if the cell at (row, col) is available for a move
+    std::uint16_t occupied() const { return static_cast<std::uint16_t>(xMask | oMask); } // Taken cells, bit row*3+col
 
     // Core rules (human-friendly labeled coordinates)
     bool placeMark(char rowLabel, int colLabel); // e.g., 'A',1  / 'B',3  — converts and forwards to (row,col)
@@ -43,12 +69,18 @@ public:
     bool isAvailable(char rowLabel, int colLabel) const;
 
     void computerMove();                        // Process a CPU player's move
+    void setDifficulty(Difficulty level, double targetWinRate = 0.4); // Target: human score per round (win 1, tie 0.5)
+    Difficulty getDifficulty() const { return difficulty; }
+    void seed(std::uint64_t value);             // Fix the CPU's random choices (session record/replay)
+    const AdaptiveAgent& agent() const { return opponent; }
     GameState evaluateBoard() const;            // Evaluate and return the current board state (win/tie/running)
     void switchTurn();                          // Switch to the other player's turn
 
     // Output / feedback
-    void printResult();                         // Print the result of the round (win/tie)
+    void printResult();                         // Print the result of the round (win/tie) and report it to the agent
+    void printResult(std::ostream& out);
     void printScores() const;                   // Print the current scores for both players
+    void printScores(std::ostream& out) const;
 
     // Read current round state
     GameState getState() const { return state; } // Getter to access the current game state
@@ -0,0 +1,113 @@
+#include "tictactoe/engine.h" // C embedding API
+#include "Driver.h"           // TicTacToe::hasLine / kFullMask
+#include "Solver.h"           // Perfect-play table
+#include "GamePool.h"         // Recycled game handles
+#include "Bits.h"             // popcount64
+#include <mutex>              // The handle pool is shared by all host threads
+#include <new>                // std::bad_alloc
+
+struct ttt_game {
+    std::uint16_t x = 0;
+    std::uint16_t o = 0;
+
+    void resetGame() { *this = ttt_game{}; }
+};
+
+namespace {
+// Handles come from a slab pool: destroy/create churn reuses released games.
+std::mutex poolMutex;
+GamePool<ttt_game, 256>& pool() {
+    static GamePool<ttt_game, 256> games;
+    return games;
+}
+
+ttt_state stateOf(std::uint16_t x, std::uint16_t o) {
+    if (!Solver::isValid(x, o)) return TTT_INVALID;
+    if (TicTacToe::hasLine(x)) return TTT_X_WINS;
+    if (TicTacToe::hasLine(o)) return TTT_O_WINS;
+    if ((x | o) == TicTacToe::kFullMask) return TTT_TIE;
+    return TTT_RUNNING;
+}
+} // namespace
+
+extern "C" {
+
+int ttt_api_version(void) {
+    return TTT_API_VERSION;
+}
+
+ttt_game* ttt_create(void) {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    try {
+        return pool().acquire();
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void ttt_destroy(ttt_game* game) {
+    if (!game) return;
+    std::lock_guard<std::mutex> lock(poolMutex);
+    pool().release(game);
+}
+
+void ttt_reset(ttt_game* game) {
+    if (game) *game = ttt_game{};
+}
+
+int ttt_make_move(ttt_game* game, int cell) {
+    if (!game || cell < 0 || cell > 8) return TTT_ERR_ARG;
+    if (stateOf(game->x, game->o) != TTT_RUNNING) return TTT_ERR_FINISHED;
+    const std::uint16_t bit = static_cast<std::uint16_t>(1u << cell);
+    if ((game->x | game->o) & bit) return TTT_ERR_OCCUPIED;
+    if (popcount64(game->x) == popcount64(game->o)) game->x = static_cast<std::uint16_t>(game->x | bit);
+    else game->o = static_cast<std::uint16_t>(game->o | bit);
+    return TTT_OK;
+}
+
+ttt_state ttt_get_state(const ttt_game* game) {
+    return game ? stateOf(game->x, game->o) : TTT_INVALID;
+}
+
+char ttt_side_to_move(const ttt_game* game) {
+    if (!game) return '?';
+    return popcount64(game->x) == popcount64(game->o) ? 'X' : 'O';
+}
+
+ttt_position ttt_get_position(const ttt_game* game) {
+    ttt_position p{0, 0};
+    if (game) {
+        p.x = game->x;
+        p.o = game->o;
+    }
+    return p;
+}
+
+int ttt_best_move(const ttt_game* game) {
+    return game ? Solver::bestMove(game->x, game->o) : -1;
+}
+
+size_t ttt_evaluate_batch(const ttt_position* positions, ttt_result* out, size_t count) {
+    if (!positions || !out) return 0;
+    size_t valid = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const std::uint16_t x = positions[i].x;
+        const std::uint16_t o = positions[i].o;
+        ttt_result& r = out[i];
+        const ttt_state s = stateOf(x, o);
+        r.state = static_cast<std::int8_t>(s);
+        if (s == TTT_INVALID) {
+            r.best_move = -1;
+            r.value = 0;
+            r.to_move = '?';
+            continue;
+        }
+        r.best_move = static_cast<std::int8_t>(Solver::bestMove(x, o));
+        r.value = static_cast<std::int8_t>(Solver::value(x, o));
+        r.to_move = popcount64(x) == popcount64(o) ? 'X' : 'O';
+        ++valid;
+    }
+    return valid;
+}
+
+} // extern "C"
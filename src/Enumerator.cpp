@@ -0,0 +1,493 @@
+#include "Enumerator.h" // Tree enumeration declarations
+#include "Bits.h"       // popcount64
+#include "Rules.h"      // Geometry line tables and the move referee
+#include <algorithm>    // std::min
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// ── Work-stealing scheduler ──────────────────────────────────────────────
+
+// Fixed set of workers, each owning a deque of index ranges. parallelFor hands
+// every worker one contiguous block. A worker pops from the back of its own
+// deque. Before running a range larger than the grain, it pushes the upper
+// half back. An idle worker steals from the front of another deque, where the
+// oldest and largest ranges sit. A few uneven regions of a layer therefore
+// spread over every worker without a central queue.
+class StealingPool {
+public:
+    using Body = std::function<void(int worker, std::size_t begin, std::size_t end)>;
+
+    explicit StealingPool(int threads) {
+        int n = threads > 0 ? threads : static_cast<int>(std::thread::hardware_concurrency());
+        if (n <= 0) n = 1;
+        for (int i = 0; i < n; ++i) queues.push_back(std::make_unique<Queue>());
+        for (int i = 0; i < n; ++i) workers.emplace_back([this, i] { loop(i); });
+    }
+
+    ~StealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& t : workers) t.join();
+    }
+
+    StealingPool(const StealingPool&) = delete;
+    StealingPool& operator=(const StealingPool&) = delete;
+
+    int size() const { return static_cast<int>(workers.size()); }
+    std::uint64_t steals() const { return stolen.load(std::memory_order_relaxed); }
+
+    // Runs fn over [0, n) in ranges of at most grain items; returns once all of them ran.
+    void parallelFor(std::size_t n, std::size_t grain, const Body& fn) {
+        if (n == 0) return;
+        const std::size_t per = (n + queues.size() - 1) / queues.size();
+        for (std::size_t w = 0; w < queues.size(); ++w) {
+            const std::size_t begin = w * per;
+            const std::size_t end = std::min(n, begin + per);
+            if (begin < end) queues[w]->ranges.push_back({begin, end});
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        body = &fn;
+        chunk = grain ? grain : 1;
+        remaining.store(n, std::memory_order_release);
+        busy = size();
+        ++generation;
+        wake.notify_all();
+        done.wait(lock, [this] { return busy == 0; });
+        body = nullptr;
+    }
+
+private:
+    struct Range {
+        std::size_t begin;
+        std::size_t end;
+    };
+    struct alignas(64) Queue { // Own cache line: the owner and thieves only meet on the lock
+        std::mutex mutex;
+        std::deque<Range> ranges;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const Body* body = nullptr;
+    std::size_t chunk = 1;
+    std::uint64_t generation = 0;
+    int busy = 0;
+    bool stopping = false;
+    std::atomic<std::size_t> remaining{0};
+    std::atomic<std::uint64_t> stolen{0};
+
+    bool take(int self, Range& out) {
+        Queue& q = *queues[static_cast<size_t>(self)];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.ranges.empty()) return false;
+        out = q.ranges.back();
+        q.ranges.pop_back();
+        return true;
+    }
+
+    bool steal(int self, Range& out) {
+        const int n = size();
+        for (int i = 1; i < n; ++i) {
+            Queue& q = *queues[static_cast<size_t>((self + i) % n)];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.ranges.empty()) continue;
+            out = q.ranges.front();
+            q.ranges.pop_front();
+            stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void loop(int self) {
+        std::uint64_t seen = 0;
+        for (;;) {
+            const Body* fn;
+            std::size_t grain;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                fn = body;
+                grain = chunk;
+            }
+            while (remaining.load(std::memory_order_acquire) > 0) {
+                Range r;
+                if (!take(self, r) && !steal(self, r)) { // The last ranges are running elsewhere
+                    std::this_thread::yield();
+                    continue;
+                }
+                while (r.end - r.begin > grain) {
+                    const std::size_t mid = r.begin + (r.end - r.begin) / 2;
+                    Queue& q = *queues[static_cast<size_t>(self)];
+                    std::lock_guard<std::mutex> lock(q.mutex);
+                    q.ranges.push_back({mid, r.end});
+                    r.end = mid;
+                }
+                (*fn)(self, r.begin, r.end);
+                remaining.fetch_sub(r.end - r.begin, std::memory_order_acq_rel);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busy == 0) done.notify_one();
+        }
+    }
+};
+
+// ── Square symmetries ────────────────────────────────────────────────────
+
+// The eight rotations and reflections of an N x N board, applied to a cell
+// mask one byte at a time through lookup tables.
+template <int N>
+struct SquareSymmetries {
+    static_assert(N * N <= 16, "masks are 16 bits");
+    std::array<std::array<std::array<std::uint16_t, 256>, 2>, 8> bytes{};
+
+    SquareSymmetries() {
+        for (int s = 0; s < 8; ++s)
+            for (int cell = 0; cell < N * N; ++cell) {
+                const int r = cell / N, c = cell % N, m = N - 1;
+                int tr = r, tc = c;
+                switch (s) {
+                case 1: tr = c;     tc = m - r; break; // Rotate 90
+                case 2: tr = m - r; tc = m - c; break; // Rotate 180
+                case 3: tr = m - c; tc = r;     break; // Rotate 270
+                case 4: tr = r;     tc = m - c; break; // Mirror columns
+                case 5: tr = m - r; tc = c;     break; // Mirror rows
+                case 6: tr = c;     tc = r;     break; // Main diagonal
+                case 7: tr = m - c; tc = m - r; break; // Anti-diagonal
+                default: break;
+                }
+                const auto image = static_cast<std::uint16_t>(1u << (tr * N + tc));
+                for (int v = 0; v < 256; ++v)
+                    if ((v >> (cell % 8)) & 1) bytes[static_cast<size_t>(s)][static_cast<size_t>(cell / 8)][static_cast<size_t>(v)] |= image;
+            }
+    }
+
+    std::uint16_t apply(int s, std::uint16_t mask) const {
+        const auto& t = bytes[static_cast<size_t>(s)];
+        return static_cast<std::uint16_t>(t[0][mask & 0xFF] | t[1][mask >> 8]);
+    }
+
+    std::uint32_t canonical(std::uint16_t x, std::uint16_t o) const { // Smallest (x, o) key over the eight images
+        std::uint32_t best = static_cast<std::uint32_t>(x) << 16 | o;
+        for (int s = 1; s < 8; ++s) {
+            const std::uint32_t key = static_cast<std::uint32_t>(apply(s, x)) << 16 | apply(s, o);
+            best = std::min(best, key);
+        }
+        return best;
+    }
+};
+
+// ── Layered walk ─────────────────────────────────────────────────────────
+
+// Distinct positions at one ply. counts holds `labels` game counts per key,
+// one per first-move class.
+struct Layer {
+    std::vector<std::uint32_t> keys;
+    std::vector<std::uint64_t> counts;
+};
+
+constexpr int kShards = 64;
+
+struct Shard {
+    std::unordered_map<std::uint32_t, std::uint32_t> index; // Key -> position in out
+    Layer out;
+};
+
+struct WorkerTally {
+    std::array<Shard, kShards> shards;
+    DepthStats here;                            // children of the layer being expanded
+    DepthStats next;                            // nodes and outcomes one ply down
+    std::vector<std::array<std::uint64_t, 3>> labelOutcomes; // X, O, tie per first-move class
+};
+
+std::size_t shardOf(std::uint32_t key) { return (key * 0x9E3779B1u) >> 26; } // Top 6 bits of a multiplicative hash
+
+void addOutcome(DepthStats& d, GameState state, std::uint64_t games) {
+    if (state == GameState::HUMAN_WIN) d.xWins += games;
+    else if (state == GameState::CPU_WIN) d.oWins += games;
+    else d.ties += games;
+}
+
+int outcomeSlot(GameState state) { return state == GameState::HUMAN_WIN ? 0 : state == GameState::CPU_WIN ? 1 : 2; }
+
+template <class G>
+EnumerationStats walk(std::uint16_t rootX, std::uint16_t rootO, int threads) {
+    static const SquareSymmetries<G::kSide> symmetry;
+    constexpr int kCells = G::kCells;
+
+    EnumerationStats stats;
+    stats.side = G::kSide;
+    stats.rootPly = popcount64(static_cast<std::uint64_t>(rootX | rootO));
+    stats.depths.resize(static_cast<size_t>(kCells + 1));
+    const auto start = Clock::now();
+
+    stats.depths[static_cast<size_t>(stats.rootPly)].nodes = 1;
+    const GameState rootState = Rules<G>::evaluate(rootX, rootO);
+    if (rootState != GameState::RUNNING) {
+        addOutcome(stats.depths[static_cast<size_t>(stats.rootPly)], rootState, 1);
+        return stats;
+    }
+
+    // Children of the root: terminal ones are tallied here, the rest become
+    // first-move classes (one per distinct canonical child).
+    const char rootSide = popcount64(rootX) == popcount64(rootO) ? 'X' : 'O';
+    std::vector<std::uint32_t> labelKeys;
+    std::vector<std::uint64_t> multiplicity;
+    std::vector<int> cellLabel;
+    DepthStats& rootDepth = stats.depths[static_cast<size_t>(stats.rootPly)];
+    DepthStats& firstDepth = stats.depths[static_cast<size_t>(stats.rootPly + 1)];
+    for (int cell = 0; cell < kCells; ++cell) {
+        const auto bit = static_cast<std::uint16_t>(1u << cell);
+        if ((rootX | rootO) & bit) continue;
+        const auto x = static_cast<std::uint16_t>(rootSide == 'X' ? rootX | bit : rootX);
+        const auto o = static_cast<std::uint16_t>(rootSide == 'O' ? rootO | bit : rootO);
+        const GameState state = Rules<G>::afterMove(rootSide, rootSide == 'X' ? x : o, static_cast<std::uint16_t>(x | o), cell);
+        ++rootDepth.children;
+        ++firstDepth.nodes;
+        FirstMoveStats first;
+        first.cell = cell;
+        if (state != GameState::RUNNING) {
+            addOutcome(firstDepth, state, 1);
+            (state == GameState::HUMAN_WIN ? first.xWins : state == GameState::CPU_WIN ? first.oWins : first.ties) = 1;
+            cellLabel.push_back(-1);
+        } else {
+            const std::uint32_t key = symmetry.canonical(x, o);
+            auto it = std::find(labelKeys.begin(), labelKeys.end(), key);
+            if (it == labelKeys.end()) {
+                labelKeys.push_back(key);
+                multiplicity.push_back(0);
+                it = labelKeys.end() - 1;
+            }
+            const auto label = static_cast<size_t>(it - labelKeys.begin());
+            ++multiplicity[label];
+            cellLabel.push_back(static_cast<int>(label));
+        }
+        stats.firstMoves.push_back(first);
+    }
+
+    const std::size_t labels = labelKeys.size();
+    Layer layer;
+    layer.keys = labelKeys;
+    layer.counts.assign(labels * labels, 0);
+    for (std::size_t k = 0; k < labels; ++k) layer.counts[k * labels + k] = 1;
+
+    StealingPool pool(threads);
+    std::vector<WorkerTally> tallies(static_cast<size_t>(pool.size()));
+    for (auto& t : tallies) t.labelOutcomes.assign(labels, {0, 0, 0});
+    std::array<Layer, kShards> merged;
+
+    for (int ply = stats.rootPly + 1; !layer.keys.empty(); ++ply) {
+        stats.positions += layer.keys.size();
+
+        pool.parallelFor(layer.keys.size(), 256, [&](int worker, std::size_t begin, std::size_t end) {
+            WorkerTally& t = tallies[static_cast<size_t>(worker)];
+            for (std::size_t i = begin; i < end; ++i) {
+                const auto x = static_cast<std::uint16_t>(layer.keys[i] >> 16);
+                const auto o = static_cast<std::uint16_t>(layer.keys[i] & 0xFFFF);
+                const std::uint64_t* counts = &layer.counts[i * labels];
+                std::uint64_t games = 0;
+                for (std::size_t k = 0; k < labels; ++k) games += multiplicity[k] * counts[k];
+
+                const char side = popcount64(x) == popcount64(o) ? 'X' : 'O';
+                const auto occupied = static_cast<std::uint16_t>(x | o);
+                for (int cell = 0; cell < kCells; ++cell) {
+                    const auto bit = static_cast<std::uint16_t>(1u << cell);
+                    if (occupied & bit) continue;
+                    const auto cx = static_cast<std::uint16_t>(side == 'X' ? x | bit : x);
+                    const auto co = static_cast<std::uint16_t>(side == 'O' ? o | bit : o);
+                    const GameState state = Rules<G>::afterMove(side, side == 'X' ? cx : co, static_cast<std::uint16_t>(occupied | bit), cell);
+                    t.here.children += games;
+                    t.next.nodes += games;
+                    if (state != GameState::RUNNING) {
+                        addOutcome(t.next, state, games);
+                        const int slot = outcomeSlot(state);
+                        for (std::size_t k = 0; k < labels; ++k) t.labelOutcomes[k][static_cast<size_t>(slot)] += counts[k];
+                        continue;
+                    }
+                    const std::uint32_t key = symmetry.canonical(cx, co);
+                    Shard& shard = t.shards[shardOf(key)];
+                    auto [it, added] = shard.index.try_emplace(key, static_cast<std::uint32_t>(shard.out.keys.size()));
+                    if (added) {
+                        shard.out.keys.push_back(key);
+                        shard.out.counts.resize(shard.out.counts.size() + labels, 0);
+                    }
+                    std::uint64_t* into = &shard.out.counts[static_cast<size_t>(it->second) * labels];
+                    for (std::size_t k = 0; k < labels; ++k) into[k] += counts[k];
+                }
+            }
+        });
+
+        // Fold each shard across workers; shards are disjoint, so they merge in parallel.
+        pool.parallelFor(kShards, 1, [&](int, std::size_t begin, std::size_t end) {
+            for (std::size_t s = begin; s < end; ++s) {
+                Layer& out = merged[s];
+                out.keys.clear();
+                out.counts.clear();
+                std::unordered_map<std::uint32_t, std::uint32_t> index;
+                for (auto& t : tallies) {
+                    Shard& shard = t.shards[s];
+                    for (std::size_t j = 0; j < shard.out.keys.size(); ++j) {
+                        auto [it, added] = index.try_emplace(shard.out.keys[j], static_cast<std::uint32_t>(out.keys.size()));
+                        if (added) {
+                            out.keys.push_back(shard.out.keys[j]);
+                            out.counts.insert(out.counts.end(), shard.out.counts.begin() + static_cast<std::ptrdiff_t>(j * labels),
+                                              shard.out.counts.begin() + static_cast<std::ptrdiff_t>((j + 1) * labels));
+                        } else {
+                            for (std::size_t k = 0; k < labels; ++k)
+                                out.counts[static_cast<size_t>(it->second) * labels + k] += shard.out.counts[j * labels + k];
+                        }
+                    }
+                    shard.index.clear();
+                    shard.out.keys.clear();
+                    shard.out.counts.clear();
+                }
+            }
+        });
+
+        layer.keys.clear();
+        layer.counts.clear();
+        for (const Layer& part : merged) {
+            layer.keys.insert(layer.keys.end(), part.keys.begin(), part.keys.end());
+            layer.counts.insert(layer.counts.end(), part.counts.begin(), part.counts.end());
+        }
+
+        DepthStats& here = stats.depths[static_cast<size_t>(ply)];
+        DepthStats& next = stats.depths[static_cast<size_t>(std::min(ply + 1, kCells))];
+        for (auto& t : tallies) {
+            here.children += t.here.children;
+            next.nodes += t.next.nodes;
+            next.xWins += t.next.xWins;
+            next.oWins += t.next.oWins;
+            next.ties += t.next.ties;
+            t.here = DepthStats{};
+            t.next = DepthStats{};
+        }
+    }
+
+    for (std::size_t i = 0; i < stats.firstMoves.size(); ++i) {
+        if (cellLabel[i] < 0) continue;
+        FirstMoveStats& first = stats.firstMoves[i];
+        for (const auto& t : tallies) {
+            const auto& o = t.labelOutcomes[static_cast<size_t>(cellLabel[i])];
+            first.xWins += o[0];
+            first.oWins += o[1];
+            first.ties += o[2];
+        }
+    }
+
+    stats.steals = pool.steals();
+    stats.workers = pool.size();
+    stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return stats;
+}
+
+std::string cellName(int side, int cell) { // "B2", as the prompts spell it
+    const char name[3] = {static_cast<char>('A' + cell / side), static_cast<char>('1' + cell % side), '\0'};
+    return name;
+}
+
+double percent(std::uint64_t part, std::uint64_t whole) {
+    return whole ? 100.0 * static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+}
+} // namespace
+
+bool Enumerator::parseRoot(const std::string& spec, int& side, std::uint64_t& x, std::uint64_t& o, std::string& error) {
+    x = o = 0;
+    if (spec == "3x3" || spec == "4x4") {
+        side = spec[0] - '0';
+        return true;
+    }
+    if (spec.size() != 9 && spec.size() != 16) {
+        error = "--enumerate takes 3x3, 4x4 or a 9/16-cell position such as X...O....";
+        return false;
+    }
+    side = spec.size() == 9 ? 3 : 4;
+    for (std::size_t cell = 0; cell < spec.size(); ++cell) {
+        const char c = spec[cell];
+        if (c == 'X' || c == 'x') x |= 1ULL << cell;
+        else if (c == 'O' || c == 'o') o |= 1ULL << cell;
+        else if (c != '.' && c != '-' && c != '_') {
+            error = std::string("Unexpected '") + c + "' in position (use '.', 'X' and 'O')";
+            return false;
+        }
+    }
+    const int xs = popcount64(x), os = popcount64(o);
+    if (xs != os && xs != os + 1) {
+        error = "Position is unreachable: X moves first, so X has as many marks as O or one more";
+        return false;
+    }
+    const GameState state = side == 3 ? Rules<ClassicGeometry>::evaluate(static_cast<std::uint16_t>(x), static_cast<std::uint16_t>(o))
+                                      : Rules<SquareGeometry>::evaluate(static_cast<std::uint16_t>(x), static_cast<std::uint16_t>(o));
+    const bool xLine = state == GameState::HUMAN_WIN;
+    const bool oLine = side == 3 ? Rules<ClassicGeometry>::hasLine(static_cast<std::uint16_t>(o))
+                                 : Rules<SquareGeometry>::hasLine(static_cast<std::uint16_t>(o));
+    if ((xLine && oLine) || (xLine && xs == os) || (oLine && xs != os)) {
+        error = "Position is unreachable: the game would already have ended";
+        return false;
+    }
+    return true;
+}
+
+EnumerationStats Enumerator::run(int side, std::uint64_t x, std::uint64_t o, int threads) {
+    const auto rx = static_cast<std::uint16_t>(x), ro = static_cast<std::uint16_t>(o);
+    return side == 4 ? walk<SquareGeometry>(rx, ro, threads) : walk<ClassicGeometry>(rx, ro, threads);
+}
+
+void Enumerator::printSummary(const EnumerationStats& stats, std::ostream& out) {
+    std::uint64_t xWins = 0, oWins = 0, ties = 0;
+    for (const DepthStats& d : stats.depths) {
+        xWins += d.xWins;
+        oWins += d.oWins;
+        ties += d.ties;
+    }
+    const std::uint64_t games = xWins + oWins + ties;
+
+    out << "Enumerated the " << stats.side << "x" << stats.side << " tree from ply " << stats.rootPly << ": " << games
+        << " games, " << stats.positions << " canonical positions expanded in " << std::fixed << std::setprecision(2)
+        << stats.seconds << " s on " << stats.workers << " workers (" << stats.steals << " steals)\n";
+    out << " ply" << std::setw(16) << "games" << std::setw(16) << "X wins" << std::setw(16) << "O wins" << std::setw(16)
+        << "ties" << std::setw(11) << "branching\n";
+    for (std::size_t ply = static_cast<size_t>(stats.rootPly); ply < stats.depths.size(); ++ply) {
+        const DepthStats& d = stats.depths[ply];
+        if (!d.nodes) break;
+        const std::uint64_t running = d.nodes - d.xWins - d.oWins - d.ties;
+        out << std::setw(4) << ply << std::setw(16) << d.nodes << std::setw(16) << d.xWins << std::setw(16) << d.oWins
+            << std::setw(16) << d.ties << std::setw(10) << std::setprecision(2)
+            << (running ? static_cast<double>(d.children) / static_cast<double>(running) : 0.0) << "\n";
+    }
+    out << "total" << std::setw(15) << games << std::setw(15) << std::setprecision(1) << percent(xWins, games) << "%"
+        << std::setw(15) << percent(oWins, games) << "%" << std::setw(15) << percent(ties, games) << "%\n";
+
+    if (!stats.firstMoves.empty()) {
+        out << "first move" << std::setw(16) << "games" << std::setw(9) << "X win" << std::setw(9) << "O win"
+            << std::setw(9) << "tie\n";
+        for (const FirstMoveStats& f : stats.firstMoves) {
+            const std::uint64_t n = f.xWins + f.oWins + f.ties;
+            out << "  " << std::left << std::setw(8) << cellName(stats.side, f.cell) << std::right << std::setw(16) << n
+                << std::setw(8) << percent(f.xWins, n) << "%" << std::setw(8) << percent(f.oWins, n) << "%"
+                << std::setw(7) << percent(f.ties, n) << "%\n";
+        }
+    }
+    out.unsetf(std::ios::floatfield);
+}
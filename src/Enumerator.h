@@ -0,0 +1,58 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <cstdint>
+#include <iosfwd>  // std::ostream forward declaration
+#include <string>
+#include <vector>
+
+// Game counts at one ply of the tree. Every count is in games (move
+// sequences), not positions.
+struct DepthStats {
+    std::uint64_t nodes = 0;    // Games that reach this ply
+    std::uint64_t xWins = 0;    // ... and end here with a line for X
+    std::uint64_t oWins = 0;
+    std::uint64_t ties = 0;
+    std::uint64_t children = 0; // Moves out of the running ones (for the branching factor)
+};
+
+// Outcomes of every game that starts with one move from the root.
+struct FirstMoveStats {
+    int cell = 0;
+    std::uint64_t xWins = 0;
+    std::uint64_t oWins = 0;
+    std::uint64_t ties = 0;
+};
+
+struct EnumerationStats {
+    int side = 3;                          // 3 or 4
+    int rootPly = 0;                       // Marks on the root position
+    std::vector<DepthStats> depths;        // Indexed by ply, rootPly..side*side
+    std::vector<FirstMoveStats> firstMoves;
+    std::uint64_t positions = 0;           // Canonical positions expanded
+    std::uint64_t steals = 0;              // Ranges taken from another worker's deque
+    int workers = 0;
+    double seconds = 0.0;
+};
+
+// Exhaustive game-tree statistics for the 3x3 and 4x4 boards (--enumerate).
+//
+// The naive walk visits every move sequence, and 4x4 has about 10^13 of
+// them. Instead the tree is walked a ply at a time. Each layer holds
+// distinct positions, reduced to a canonical form under the square's eight
+// symmetries, with the number of games that reach each one. Expanding a
+// position multiplies its children by that count. Transpositions and mirror
+// images are therefore expanded once, and every count is still exact. Counts
+// are kept per first move, so first-move outcomes come out of the same pass.
+//
+// A layer is expanded in parallel by a small work-stealing scheduler. Each
+// worker starts with one contiguous range and splits it in half lazily,
+// keeping the halves on its own deque. Idle workers steal the oldest,
+// largest range from another deque. Children go into per-worker maps
+// sharded by hash. The shards are then merged in parallel into the next
+// layer.
+class Enumerator {
+public:
+    // "3x3", "4x4", or a 9/16-cell string such as "X...O...." ('.', 'X', 'O'; rows in order).
+    static bool parseRoot(const std::string& spec, int& side, std::uint64_t& x, std::uint64_t& o, std::string& error);
+    static EnumerationStats run(int side, std::uint64_t x, std::uint64_t o, int threads); // threads <= 0: hardware concurrency
+    static void printSummary(const EnumerationStats& stats, std::ostream& out);
+};
@@ -0,0 +1,211 @@
+#include "EventLoop.h" // Event loop declarations
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <fcntl.h>      // O_NONBLOCK on the wake pipe and accepted sockets
+#include <utility>      // std::exchange
+#include <poll.h>       // poll() over inputs, the listener and the wake pipe
+#include <sys/socket.h> // accept()
+#include <unistd.h>     // read / write / pipe / close
+
+EventLoop::EventLoop(int workerThreads) : workers(workerThreads) {
+    int fds[2];
+    if (::pipe(fds) == 0) {
+        wakeRead = fds[0];
+        wakeWrite = fds[1];
+        ::fcntl(wakeRead, F_SETFL, ::fcntl(wakeRead, F_GETFL) | O_NONBLOCK);
+        ::fcntl(wakeWrite, F_SETFL, ::fcntl(wakeWrite, F_GETFL) | O_NONBLOCK); // post() must never block a worker
+    }
+}
+
+EventLoop::~EventLoop() {
+    workers.shutdown(); // Members are destroyed after this body: a running job could still post() to the pipe
+    if (wakeRead >= 0) ::close(wakeRead);
+    if (wakeWrite >= 0) ::close(wakeWrite);
+}
+
+void EventLoop::OffloadAwaiter::await_suspend(std::coroutine_handle<> h) {
+    ++loop.pendingJobs;
+    loop.workers.submit([this, h] {
+        job();
+        loop.post(h);
+    });
+}
+
+void EventLoop::post(std::coroutine_handle<> h) {
+    {
+        std::lock_guard<std::mutex> lock(readyMutex);
+        ready.push_back(h);
+    }
+    const char byte = 1;
+    [[maybe_unused]] ssize_t n = ::write(wakeWrite, &byte, 1); // Non-blocking: a full pipe (EAGAIN) already guarantees a wake-up
+}
+
+bool EventLoop::lineReady(int fd) {
+    const Input& in = inputs[fd];
+    return in.eof || in.buffer.find('\n') != std::string::npos;
+}
+
+std::optional<std::string> EventLoop::takeLine(int fd) {
+    Input& in = inputs[fd];
+    const std::size_t nl = in.buffer.find('\n');
+    if (nl != std::string::npos && nl > kMaxLine) { // Arrived in one read with its newline; still too long
+        drop(fd);
+        return std::nullopt;
+    }
+    if (nl == std::string::npos) { // End of input: hand out a final unterminated line, then nothing
+        if (in.buffer.empty()) return std::nullopt;
+        std::string last = std::move(in.buffer);
+        in.buffer.clear();
+        return last;
+    }
+    std::string line = in.buffer.substr(0, nl);
+    in.buffer.erase(0, nl + 1);
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    return line;
+}
+
+void EventLoop::write(int fd, std::string_view text) {
+    Output& out = outputs[fd];
+    if (out.dropped) return;
+    while (out.pending.empty() && !text.empty()) { // Keep order: nothing goes out ahead of the queue
+        ssize_t n = ::write(fd, text.data(), text.size());
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break; // Full; poll() says when it drains
+        if (n <= 0) { // Peer gone: the session notices at its next read
+            out.dropped = true;
+            return;
+        }
+        text.remove_prefix(static_cast<std::size_t>(n));
+    }
+    out.pending.append(text);
+    if (out.pending.size() > kMaxPending) drop(fd); // The peer has stopped reading its replies
+}
+
+void EventLoop::flush(int fd) {
+    auto it = outputs.find(fd);
+    if (it == outputs.end()) return;
+    Output& out = it->second;
+    std::size_t sent = 0;
+    while (sent < out.pending.size()) {
+        ssize_t n = ::write(fd, out.pending.data() + sent, out.pending.size() - sent);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (n <= 0) {
+            out.dropped = true;
+            sent = out.pending.size();
+            break;
+        }
+        sent += static_cast<std::size_t>(n);
+    }
+    out.pending.erase(0, sent);
+    if (out.closing && out.pending.empty()) {
+        outputs.erase(it);
+        ::close(fd);
+    }
+}
+
+void EventLoop::drop(int fd) {
+    if (auto in = inputs.find(fd); in != inputs.end()) {
+        in->second.buffer.clear();
+        in->second.eof = true; // A waiting session is resumed with nullopt by run()
+    }
+    Output& out = outputs[fd];
+    out.dropped = true;
+    out.pending.clear();
+}
+
+void EventLoop::close(int fd) {
+    inputs.erase(fd);
+    auto it = outputs.find(fd);
+    if (it != outputs.end() && !it->second.pending.empty()) { // Let the last replies go out first
+        it->second.closing = true;
+        return;
+    }
+    if (it != outputs.end()) outputs.erase(it);
+    ::close(fd);
+}
+
+void EventLoop::listen(int fd, std::function<void(int)> accepted) {
+    listenFd = fd;
+    onAccept = std::move(accepted);
+}
+
+int EventLoop::run() {
+    if (wakeRead < 0) return 1;
+    std::vector<pollfd> fds;
+    std::vector<std::coroutine_handle<>> resumable;
+    char chunk[64 * 1024];
+
+    for (;;) {
+        { // Sessions whose offloaded job has finished
+            std::lock_guard<std::mutex> lock(readyMutex);
+            resumable.swap(ready);
+        }
+        for (auto h : resumable) {
+            --pendingJobs;
+            h.resume();
+        }
+        resumable.clear();
+
+        fds.clear();
+        fds.push_back({wakeRead, POLLIN, 0});
+        if (listenFd >= 0) fds.push_back({listenFd, POLLIN, 0});
+        for (const auto& [fd, out] : outputs)
+            if (!out.pending.empty()) fds.push_back({fd, POLLOUT, 0});
+        for (const auto& [fd, in] : inputs) {
+            const auto out = outputs.find(fd);
+            const bool backlogged = out != outputs.end() && !out->second.pending.empty(); // Replies first, then more input
+            if (in.waiter && !in.eof && !backlogged) fds.push_back({fd, POLLIN, 0});
+        }
+        if (fds.size() == 1 && pendingJobs == 0) return 0; // Nothing left to wait for
+
+        if (::poll(fds.data(), static_cast<nfds_t>(fds.size()), -1) < 0) {
+            if (errno == EINTR) continue;
+            return 1;
+        }
+
+        for (const pollfd& p : fds) {
+            if (!p.revents) continue;
+            if (p.events & POLLOUT) {
+                flush(p.fd);
+            } else if (p.fd == wakeRead) {
+                [[maybe_unused]] ssize_t n = ::read(wakeRead, chunk, sizeof chunk); // Drain; ready list is checked above
+            } else if (p.fd == listenFd) {
+                int client = ::accept(listenFd, nullptr, nullptr);
+                if (client < 0) continue;
+                ::fcntl(client, F_SETFL, ::fcntl(client, F_GETFL) | O_NONBLOCK); // One slow reader must not stall the loop
+                onAccept(client);
+            } else {
+                auto it = inputs.find(p.fd);
+                if (it == inputs.end()) continue;
+                ssize_t n = ::read(p.fd, chunk, sizeof chunk);
+                if (n < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) continue;
+                if (n <= 0) it->second.eof = true;
+                else it->second.buffer.append(chunk, static_cast<std::size_t>(n));
+                if (it->second.buffer.size() > kMaxLine && it->second.buffer.find('\n') == std::string::npos)
+                    drop(p.fd); // No newline in sight: not a move
+
+                if (it->second.waiter && lineReady(p.fd)) {
+                    auto h = std::exchange(it->second.waiter, nullptr);
+                    h.resume(); // May add or erase inputs; `it` is not used again
+                }
+            }
+        }
+    }
+}
+
+#else // Windows: no poll() on console handles or pipes
+
+EventLoop::EventLoop(int workerThreads) : workers(workerThreads) {}
+EventLoop::~EventLoop() = default;
+void EventLoop::OffloadAwaiter::await_suspend(std::coroutine_handle<> h) { loop.post(h); }
+void EventLoop::post(std::coroutine_handle<>) {}
+bool EventLoop::lineReady(int) { return true; }
+std::optional<std::string> EventLoop::takeLine(int) { return std::nullopt; }
+void EventLoop::write(int, std::string_view) {}
+void EventLoop::close(int) {}
+void EventLoop::listen(int, std::function<void(int)>) {}
+int EventLoop::run() { return 1; }
+
+#endif
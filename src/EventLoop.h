@@ -0,0 +1,116 @@
+#pragma once // Ensure the header is included only once during compilation
+#include "WorkerPool.h" // Offloaded AI moves
+#include <coroutine>
+#include <exception>    // std::terminate for escaped exceptions
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Single-threaded scheduler for coroutine game sessions (POSIX poll()).
+//
+// A session is a coroutine returning Task. It co_awaits readLine(fd) for
+// input and offload(job) for anything slow, such as AI thinking. The loop
+// thread resumes it once a full line has arrived or once the job has finished
+// on the worker pool. Many sessions, on terminals, pipes or accepted sockets,
+// therefore share one thread, and no session blocks another while waiting.
+// Workers hand finished jobs back through a mutex-guarded ready list and a
+// self-pipe that wakes poll().
+//
+// Accepted sockets are non-blocking. write() queues whatever the peer does
+// not take at once and the loop sends the rest on POLLOUT; while a queue is
+// non-empty, that fd's input is not read. A peer whose queue passes
+// kMaxPending, or who sends a line longer than kMaxLine, is dropped: its
+// session sees end of input and further writes to it are discarded.
+//
+// Not available on Windows (no poll() on pipes); EventLoop::supported() says
+// whether this build has it.
+
+// Eagerly started, detached coroutine: the frame frees itself when the body returns.
+struct Task {
+    struct promise_type {
+        Task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+class EventLoop {
+public:
+    static constexpr std::size_t kMaxLine = 4096;        // Longest input line a peer may send
+    static constexpr std::size_t kMaxPending = 1 << 20;  // Most unsent output queued for one fd
+
+    static constexpr bool supported() {
+#if defined(_WIN32)
+        return false;
+#else
+        return true;
+#endif
+    }
+
+    explicit EventLoop(int workerThreads);
+    ~EventLoop();
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    struct LineAwaiter { // co_await loop.readLine(fd): the next line without '\n', or nullopt at end of input
+        EventLoop& loop;
+        int fd;
+        bool await_ready() const { return loop.lineReady(fd); }
+        void await_suspend(std::coroutine_handle<> h) { loop.inputs[fd].waiter = h; }
+        std::optional<std::string> await_resume() { return loop.takeLine(fd); }
+    };
+
+    struct OffloadAwaiter { // co_await loop.offload(job): job runs on a worker, the session resumes on the loop
+        EventLoop& loop;
+        std::function<void()> job;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h);
+        void await_resume() const noexcept {}
+    };
+
+    LineAwaiter readLine(int fd) { return {*this, fd}; }
+    OffloadAwaiter offload(std::function<void()> job) { return {*this, std::move(job)}; }
+    void write(int fd, std::string_view text);           // Write what fd takes now, queue the rest
+    void close(int fd);                                  // Forget fd's input; close it once its queue has drained
+    void listen(int fd, std::function<void(int)> onAccept); // Accept connections on a listening socket
+
+    int run();                                           // Until no session waits on anything; 0 on success
+
+private:
+    struct Input {
+        std::string buffer;
+        bool eof = false;
+        std::coroutine_handle<> waiter;
+    };
+
+    struct Output {
+        std::string pending;                             // Bytes the peer has not taken yet
+        bool dropped = false;                            // Peer gone or over a limit: discard further writes
+        bool closing = false;                            // close() was called while pending was non-empty
+    };
+
+    std::unordered_map<int, Input> inputs;
+    std::unordered_map<int, Output> outputs;
+    int wakeRead = -1;
+    int wakeWrite = -1;
+    int listenFd = -1;
+    std::function<void(int)> onAccept;
+    int pendingJobs = 0;                                 // Offloads not yet resumed (loop thread only)
+
+    std::mutex readyMutex;
+    std::vector<std::coroutine_handle<>> ready;          // Finished offloads, filled by workers
+
+    WorkerPool workers;                                  // Shut down in ~EventLoop before the wake pipe closes
+
+    bool lineReady(int fd);
+    std::optional<std::string> takeLine(int fd);
+    void flush(int fd);                                  // Send queued output after POLLOUT
+    void drop(int fd);                                   // End fd's input and discard its output
+    void post(std::coroutine_handle<> h);                // Any thread: queue h to resume on the loop
+};
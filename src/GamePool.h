@@ -0,0 +1,70 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <cstddef>
+#include <memory> // std::unique_ptr for slabs
+#include <new>    // Placement new
+#include <vector>
+
+// Slab-allocated pool of game objects for hosts that open and close many
+// sessions (the C API, batch drivers).
+//
+// Objects are built in slabs of kSlabSize and never destroyed while the
+// pool lives. release() pushes an object onto an intrusive free list, and
+// acquire() pops it and calls resetGame() rather than constructing a new
+// one. Once the pool has grown to the peak number of live sessions, session
+// churn does no heap allocation. Not thread-safe: use one pool per thread or
+// guard it with a mutex.
+//
+// Game requirements: default constructible, void resetGame().
+template <class Game, std::size_t kSlabSize = 64>
+class GamePool {
+public:
+    GamePool() = default;
+    GamePool(const GamePool&) = delete;
+    GamePool& operator=(const GamePool&) = delete;
+    ~GamePool() {
+        for (auto& slab : slabs)
+            for (std::size_t i = 0; i < kSlabSize; ++i) slab[i].game()->~Game();
+    }
+
+    Game* acquire() { // A reset game, recycled when possible
+        if (!freeList) addSlab();
+        Slot* s = freeList;
+        freeList = s->next;
+        ++live;
+        Game* g = s->game();
+        g->resetGame();
+        return g;
+    }
+
+    void release(Game* g) { // g must come from this pool's acquire()
+        if (!g) return;
+        Slot* s = reinterpret_cast<Slot*>(g); // The game sits at offset 0 of its slot
+        s->next = freeList;
+        freeList = s;
+        --live;
+    }
+
+    std::size_t liveCount() const { return live; }
+    std::size_t capacity() const { return slabs.size() * kSlabSize; }
+
+private:
+    struct Slot {
+        alignas(Game) unsigned char storage[sizeof(Game)];
+        Slot* next;                                        // Free-list link, unused while acquired
+        Game* game() { return std::launder(reinterpret_cast<Game*>(storage)); }
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> slabs;
+    Slot* freeList = nullptr;
+    std::size_t live = 0;
+
+    void addSlab() {
+        slabs.emplace_back(new Slot[kSlabSize]);
+        Slot* slab = slabs.back().get();
+        for (std::size_t i = kSlabSize; i-- > 0;) { // Construct once; thread onto the free list in order
+            new (slab[i].storage) Game();
+            slab[i].next = freeList;
+            freeList = &slab[i];
+        }
+    }
+};
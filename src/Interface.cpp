@@ -1,33 +1,50 @@
 #include "Interface.h" // Interface declarations
+#include "AllocProfile.h" // Session allocations are charged to the interface tag
+#include "Bits.h" // lowestBit64 for the CPU's reply
+#include "StartupProfile.h" // Keeps the wait for the first move out of the startup total
 #include <iostream>
-#include <limits>
 
 using std::cout;
-using std::cin;
-using std::numeric_limits;
-using std::streamsize;
+
+Interface::Interface(Variant v, QubicAgent qubicAgent, int moveMs, const ValueNet* net)
+    : variant(v), qubic(qubicAgent, moveMs) {
+    qubic.setValueNet(net);
+}
 
 // Main loop to run the Tic Tac Toe game interface
 int Interface::run() {
-    do {
-        game.resetGame();
+    AllocScope scope(AllocTag::Interface); // CPU moves charge their own tag
+    if (variant == Variant::QUBIC) return loop(qubic);
+    return loop(game);
+}
 
-        while (game.getState() == GameState::RUNNING) {
-            draw();
+// Round/score/replay flow shared by every variant
+template <class Game>
+int Interface::loop(Game& g) {
+    do {
+        g.resetGame();
 
-            auto [row, col] = promptMove();
-            if (row < 0) continue; // invalid input; reprompt
+        while (g.getState() == GameState::RUNNING) {
+            drawTurn(g);
 
-            game.playerMove(row, col);
+            if (!humanTurn(g)) {
+                if (inputClosed) break; // Nothing more to read; finish instead of reprompting forever
+                continue; // invalid input or taken cell; reprompt
+            }
 
-            if (game.getState() == GameState::RUNNING) {
-                game.computerMove();
+            if (g.getState() == GameState::RUNNING) {
+                const std::uint64_t before = g.occupied(); // The CPU's reply is the bit that appears across its turn
+                g.computerMove();
+                const std::uint64_t added = g.occupied() & ~before;
+                if (session) session->reply(added ? lowestBit64(added) : -1);
             }
         }
 
-        draw();
-        game.printResult();
-        game.printScores();
+        if (inputClosed) break;
+
+        g.drawBoard();
+        g.printResult();
+        g.printScores();
 
         if (!promptPlayAgain()) break;
 
@@ -37,38 +54,68 @@ int Interface::run() {
     return 0;
 }
 
-// Prompt the user for their move and validate the input
-std::pair<int,int> Interface::promptMove() const {
-    char rowChar;
-    int colNum;
-    cout << "Enter row (A-C) and column (1-3), e.g. B 2: ";
-    if (!(cin >> rowChar >> colNum)) {
-        cin.clear();
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
-        cout << "Invalid input. Please enter a row letter (A-C) and a column number (1-3).\n";
-        return {-1, -1};
+void Interface::drawTurn(const TicTacToe& g) {
+    if (coach) g.drawAnalysis(cout);
+    else g.drawBoard();
+}
+
+bool Interface::humanTurn(TicTacToe& g) {
+    auto [row, col] = promptMove();
+    if (row < 0) return false;
+    bool accepted = g.isAvailable(row, col); // A taken cell must not hand the CPU a free move
+    g.playerMove(row, col); // Prints the reason when rejected
+    return accepted;
+}
+
+bool Interface::humanTurn(Qubic& g) {
+    int cell = promptQubicMove();
+    if (cell < 0) return false;
+    bool accepted = g.isAvailable(cell);
+    g.playerMove(cell);
+    return accepted;
+}
+
+// Show a prompt and read the reply; cout is flushed because stdin is no longer read through cin
+std::optional<std::string_view> Interface::promptLine(const char* prompt) {
+    cout << prompt << std::flush;
+    StartupProfile::mark("first board and prompt");
+    std::optional<std::string_view> line;
+    if (session && session->replaying()) line = session->nextInput(); // Recorded input instead of stdin
+    else {
+        line = input.next();
+        if (line && session) session->input(*line);
     }
-    // Normalize to uppercase
-    if (rowChar >= 'a' && rowChar <= 'z') rowChar = char(rowChar - 'a' + 'A');
+    StartupProfile::mark("waiting for input", true);
+    if (!line) inputClosed = true;
+    return line;
+}
 
-    int row = TicTacToe::rowIndexFromLabel(rowChar);
-    int col = TicTacToe::colIndexFromLabel(colNum);
-    if (row < 0 || col < 0) {
-        cout << "Out of range. Use rows A, B, C and columns 1, 2, 3.\n";
+// Prompt the user for their move and validate the input
+std::pair<int,int> Interface::promptMove() {
+    auto line = promptLine("Enter row (A-C) and column (1-3), e.g. B 2: ");
+    if (!line) return {-1, -1};
+    ParsedMove move = MoveParser::classic(*line); // Also accepts b2 and cell numbers 1-9
+    if (move.status != ParseStatus::OK) {
+        cout << MoveParser::classicError(move.status);
         return {-1, -1};
     }
-    return {row, col};
+    return {move.cell / 3, move.cell % 3};
 }
 
 // Ask the user if they want to play again
-bool Interface::promptPlayAgain() const {
-    char choice;
-    cout << "Play again? (y/n): ";
-    cin >> choice;
-    return (choice == 'y' || choice == 'Y');
+bool Interface::promptPlayAgain() {
+    auto line = promptLine("Play again? (y/n): ");
+    return line && MoveParser::yes(*line);
 }
 
-// Draw the current state of the game board
-void Interface::draw() const {
-    game.drawBoard();
-}
\ No newline at end of file
+// Prompt for a Qubic move as layer, row and column, e.g. "2 B 3"
+int Interface::promptQubicMove() {
+    auto line = promptLine("Enter layer (1-4), row (A-D) and column (1-4), e.g. 2 B 3: ");
+    if (!line) return -1;
+    ParsedMove move = MoveParser::qubic(*line); // Also accepts 2b3 and cell numbers 1-64
+    if (move.status != ParseStatus::OK) {
+        cout << MoveParser::qubicError(move.status);
+        return -1;
+    }
+    return move.cell;
+}
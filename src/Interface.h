@@ -1,14 +1,37 @@
 #pragma once // Ensure the header is included only once during compilation
 #include "Driver.h" // Include the driver header for TicTacToe game logic
+#include "Qubic.h" // Include the 4x4x4 variant driven through the same flow
+#include "MoveParser.h" // Chunked stdin reader and move scanner
+#include "SessionLog.h" // Record / replay of the input stream
 #include <utility> // Include utility for std::pair usage
 
 class Interface { // Declare the Interface class to handle game interaction
 public:
+    explicit Interface(Variant variant = Variant::CLASSIC, // Which game to play (CLASSIC or QUBIC)
+                       QubicAgent qubicAgent = QubicAgent::ALPHA_BETA, int moveMs = 500,
+                       const ValueNet* net = nullptr); // Optional learned evaluator for the Qubic agents
     int run(); // Method to start and run the game loop
+    void setDifficulty(Difficulty level, double targetWinRate) { game.setDifficulty(level, targetWinRate); } // Classic CPU opponent
+    void setMoveCache(MoveCache* cache) { qubic.setMoveCache(cache); } // Qubic replies remembered across rounds
+    void setCoach(bool on) { coach = on; } // Label every empty cell with its value before each classic move
+    void seed(std::uint64_t value) { game.seed(value); qubic.seed(value); } // Reproducible CPU choices
+    void setSessionLog(SessionLog* log) { session = log; } // Record input and replies, or replay them instead of stdin
 
 private:
+    Variant variant; // Game selected at construction
     TicTacToe game{}; // Instance of the TicTacToe game
-    std::pair<int,int> promptMove() const; // Method to prompt the user for their move, returns a pair of coordinates
-    bool promptPlayAgain() const; // Method to ask the user if they want to play again
-    void draw() const; // Method to draw the current game state on the interface
-};
\ No newline at end of file
+    Qubic qubic; // Instance of the Qubic game
+    LineReader input{0}; // Lines from stdin, read in large chunks rather than through cin
+    bool inputClosed = false; // Set once stdin is exhausted; ends the session
+    SessionLog* session = nullptr; // Recording or replay in progress (not owned)
+    bool coach = false; // Show the analysis grid instead of the plain board on the human's turn
+    template <class Game> int loop(Game& g); // Shared round/score/replay flow for every variant
+    void drawTurn(const TicTacToe& g); // Board shown before the human moves (the analysis grid when coaching)
+    void drawTurn(const Qubic& g) { g.drawBoard(); } // No solved table for Qubic; always the plain board
+    bool humanTurn(TicTacToe& g); // Prompt for and apply one human move; false if the input was rejected
+    bool humanTurn(Qubic& g);
+    std::optional<std::string_view> promptLine(const char* prompt); // Show prompt and read one line; nullopt at end of input
+    std::pair<int,int> promptMove(); // Method to prompt the user for their move, returns a pair of coordinates
+    int promptQubicMove(); // Prompt for layer/row/column, returns a cell 0..63 or -1
+    bool promptPlayAgain(); // Method to ask the user if they want to play again
+};
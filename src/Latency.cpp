@@ -0,0 +1,167 @@
+#include "Latency.h" // Histogram and recorder declarations
+#include <iomanip>   // Column formatting for the report
+#include <memory>    // std::unique_ptr owning per-thread histograms
+#include <mutex>     // Guards series names and the thread-block registry
+#include <ostream>
+#include <string>
+#include <vector>
+
+// ──────────────────────────────────────────────────────────────
+// LatencyHistogram
+int LatencyHistogram::bucketOf(std::uint64_t value) {
+    if (value < static_cast<std::uint64_t>(kSubCount)) return static_cast<int>(value); // Exact below 32
+    int msb = 63;
+    while (!(value >> msb)) --msb; // Highest set bit (>= kSubBits here)
+    int shift = msb - kSubBits;
+    int sub = static_cast<int>(value >> shift) - kSubCount; // 0..31 within this power of two
+    return (shift + 1) * kSubCount + sub;
+}
+
+std::uint64_t LatencyHistogram::bucketUpper(int bucket) {
+    if (bucket < kSubCount) return static_cast<std::uint64_t>(bucket);
+    int shift = bucket / kSubCount - 1;
+    std::uint64_t sub = static_cast<std::uint64_t>(bucket % kSubCount + kSubCount);
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(std::uint64_t value) {
+    auto bump = [](std::atomic<std::uint64_t>& a, std::uint64_t n) { // Single writer: no lock prefix needed
+        a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    };
+    bump(buckets[bucketOf(value)], 1);
+    bump(total, 1);
+    bump(sum, value);
+    if (value > maxValue.load(std::memory_order_relaxed)) maxValue.store(value, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::mergeInto(LatencyHistogram& out) const {
+    auto add = [](std::atomic<std::uint64_t>& a, std::uint64_t n) {
+        a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    };
+    for (int i = 0; i < kBuckets; ++i) {
+        std::uint64_t n = buckets[i].load(std::memory_order_relaxed);
+        if (n) add(out.buckets[i], n);
+    }
+    add(out.total, total.load(std::memory_order_relaxed));
+    add(out.sum, sum.load(std::memory_order_relaxed));
+    std::uint64_t m = maxValue.load(std::memory_order_relaxed);
+    if (m > out.maxValue.load(std::memory_order_relaxed)) out.maxValue.store(m, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::clear() {
+    for (auto& b : buckets) b.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    maxValue.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const {
+    std::uint64_t n = count();
+    return n ? static_cast<double>(sum.load(std::memory_order_relaxed)) / static_cast<double>(n) : 0.0;
+}
+
+std::uint64_t LatencyHistogram::percentile(double p) const {
+    std::uint64_t n = count();
+    if (n == 0) return 0;
+    std::uint64_t rank = static_cast<std::uint64_t>(p / 100.0 * static_cast<double>(n) + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+    std::uint64_t seen = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            std::uint64_t upper = bucketUpper(i);
+            return upper < max() ? upper : max(); // Never report beyond the observed maximum
+        }
+    }
+    return max();
+}
+
+// ──────────────────────────────────────────────────────────────
+// LatencyRecorder
+namespace {
+struct ThreadSeries { // One thread's histograms, allocated lazily per series
+    std::unique_ptr<LatencyHistogram> histograms[LatencyRecorder::kMaxSeries];
+};
+
+struct SeriesRegistry {
+    std::mutex mutex;
+    std::vector<std::string> names;
+    std::vector<std::unique_ptr<ThreadSeries>> threads; // Never freed so finished threads still report
+};
+
+SeriesRegistry& seriesRegistry() {
+    static SeriesRegistry r;
+    return r;
+}
+
+ThreadSeries& localSeries() {
+    thread_local ThreadSeries* mine = [] {
+        SeriesRegistry& r = seriesRegistry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.threads.push_back(std::make_unique<ThreadSeries>());
+        return r.threads.back().get();
+    }();
+    return *mine;
+}
+
+void printNanos(std::ostream& out, std::uint64_t ns) { // Auto-scaled fixed-width duration
+    out << std::fixed << std::setprecision(2) << std::setw(9);
+    if (ns < 10000) out << static_cast<double>(ns) << " ns";
+    else if (ns < 10000000) out << static_cast<double>(ns) / 1e3 << " us";
+    else out << static_cast<double>(ns) / 1e6 << " ms";
+}
+} // namespace
+
+int LatencyRecorder::series(const char* name) {
+    SeriesRegistry& r = seriesRegistry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (size_t i = 0; i < r.names.size(); ++i)
+        if (r.names[i] == name) return static_cast<int>(i);
+    if (r.names.size() >= static_cast<size_t>(kMaxSeries)) return kMaxSeries - 1; // Overflow shares the last slot
+    r.names.emplace_back(name);
+    return static_cast<int>(r.names.size()) - 1;
+}
+
+void LatencyRecorder::record(int seriesId, std::uint64_t nanos) {
+    if (seriesId < 0 || seriesId >= kMaxSeries) return;
+    auto& slot = localSeries().histograms[seriesId];
+    if (!slot) {
+        auto fresh = std::make_unique<LatencyHistogram>();
+        SeriesRegistry& r = seriesRegistry();
+        std::lock_guard<std::mutex> lock(r.mutex); // Publish under the lock so report() never sees a half-built pointer
+        slot = std::move(fresh);
+    }
+    slot->record(nanos);
+}
+
+void LatencyRecorder::report(std::ostream& out) {
+    SeriesRegistry& r = seriesRegistry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    out << "---- computerMove latency ----\n";
+    out << std::left << std::setw(22) << "series" << std::right << std::setw(10) << "moves"
+        << std::setw(13) << "p50" << std::setw(13) << "p90" << std::setw(13) << "p99"
+        << std::setw(13) << "p99.9" << std::setw(13) << "max" << "\n";
+    for (size_t s = 0; s < r.names.size(); ++s) {
+        auto merged = std::make_unique<LatencyHistogram>();
+        for (const auto& t : r.threads)
+            if (t->histograms[s]) t->histograms[s]->mergeInto(*merged);
+        if (merged->count() == 0) continue;
+        out << std::left << std::setw(22) << r.names[s] << std::right << std::setw(10) << merged->count();
+        for (double p : {50.0, 90.0, 99.0, 99.9}) {
+            printNanos(out, merged->percentile(p));
+            out << ' ';
+        }
+        printNanos(out, merged->max());
+        out << "\n";
+    }
+    out.unsetf(std::ios::floatfield);
+}
+
+void LatencyRecorder::reset() {
+    SeriesRegistry& r = seriesRegistry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto& t : r.threads)
+        for (auto& h : t->histograms)
+            if (h) h->clear(); // Histograms stay allocated; owning threads may still be recording
+}
@@ -0,0 +1,64 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <atomic>   // Relaxed single-writer bucket updates
+#include <chrono>   // steady_clock for LatencyTimer
+#include <cstdint>  // Fixed-width bucket counters
+#include <iosfwd>   // std::ostream forward declaration for report()
+
+// Log-bucketed latency histograms in the HDR style.
+//
+// Every power of two is split into 32 linear sub-buckets, so any recorded
+// value is reported with at most ~3% relative error while a histogram covering
+// 1 ns .. hours stays a fixed 1920 counters. Each thread records into its own
+// histograms without locks; report() merges all threads per series.
+class LatencyHistogram {
+public:
+    static constexpr int kSubBits = 5;                          // 32 sub-buckets per power of two
+    static constexpr int kSubCount = 1 << kSubBits;
+    static constexpr int kBuckets = (64 - kSubBits + 1) * kSubCount;
+
+    static int bucketOf(std::uint64_t value);                   // Bucket index for a value
+    static std::uint64_t bucketUpper(int bucket);               // Largest value mapped to a bucket
+
+    void record(std::uint64_t value);                           // Owning thread only
+    void mergeInto(LatencyHistogram& out) const;                // Add this histogram's counts into out
+    void clear();                                               // Zero all counts (racy but safe while recording)
+
+    std::uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    std::uint64_t max() const { return maxValue.load(std::memory_order_relaxed); }
+    double mean() const;
+    std::uint64_t percentile(double p) const;                   // p in [0,100]
+
+private:
+    std::atomic<std::uint64_t> buckets[kBuckets]{};
+    std::atomic<std::uint64_t> total{0};
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> maxValue{0};
+};
+
+// Named latency series (e.g. "3x3/random") recorded per thread and merged on report.
+class LatencyRecorder {
+public:
+    static constexpr int kMaxSeries = 32;
+
+    static int series(const char* name);                        // Id for a name, registering it on first use
+    static void record(int seriesId, std::uint64_t nanos);      // Lock-free after the thread's first record
+    static void report(std::ostream& out);                      // p50/p90/p99/p99.9/max for every series
+    static void reset();
+};
+
+// RAII helper: records the enclosing scope's wall time into one series.
+class LatencyTimer {
+public:
+    explicit LatencyTimer(int seriesId) : id(seriesId), start(std::chrono::steady_clock::now()) {}
+    ~LatencyTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        LatencyRecorder::record(id, static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+    LatencyTimer(const LatencyTimer&) = delete;
+    LatencyTimer& operator=(const LatencyTimer&) = delete;
+
+private:
+    int id;
+    std::chrono::steady_clock::time_point start;
+};
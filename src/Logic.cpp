@@ -1,125 +1,211 @@
 #include "Driver.h" // Include the header file for TicTacToe class and related declarations
+#include "AllocProfile.h" // Per-move allocation count for --alloc-profile
+#include "Bits.h"     // popcount64 / lowestBit64 over the cell masks
+#include "Profiler.h" // Hot-path counters and scoped timers (no-ops unless TICTACTOE_PROFILE)
+#include "Latency.h"  // Per-move latency histograms (always on; two clock reads per CPU move)
+#include "Rules.h"    // Compile-time line tables for the 3x3 geometry
+#include "Solver.h"   // Per-cell move values for the coaching grid
+#include "StartupProfile.h" // First-move probe for --startup-profile
+#include <array>    // Per-cell values for the coaching grid
 #include <iostream> // For input/output stream operations
-#include <random>   // For random number generation (used in computerMove)
 #include <chrono>   // For time-related functions (used to seed RNG)
-#include <vector>   // For using std::vector (used in computerMove)
+#include <thread>   // std::this_thread::get_id (per-thread RNG seeding)
+#include <functional> // std::hash for thread ids
 #include <cctype>
 
 using std::cout; // Use cout from std namespace
 
 TicTacToe::TicTacToe() // Constructor for TicTacToe class
-    : state(GameState::RUNNING), currentPlayer('X'), scoreHuman(0), scoreCPU(0) { // Initialize state, currentPlayer, and scores
+    : state(GameState::RUNNING), xToMove(true), scoreHuman(0), scoreCPU(0), // Initialize state, side to move, and scores
+      rng((static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count()) ^
+           std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1) { // Seeded with current time and thread id
     resetGame(); // Reset the game board and state
 }
 
+void TicTacToe::seed(std::uint64_t value) { // Make every CPU choice a function of value
+    auto mix = [](std::uint64_t v) { // splitmix64: nearby seeds give unrelated streams
+        v += 0x9E3779B97F4A7C15ULL;
+        v = (v ^ (v >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        v = (v ^ (v >> 27)) * 0x94D049BB133111EBULL;
+        return v ^ (v >> 31);
+    };
+    rng = mix(value) | 1; // xorshift state must be non-zero
+    opponent.seed(mix(value + 1)); // The solved-table agent draws from its own stream
+}
+
 void TicTacToe::resetGame() { // Reset the game board and state
-    for (auto& row : board) row.fill(' '); // Fill each row with spaces (empty cells)
+    xMask = oMask = 0; // Clear both players' cells
     state = GameState::RUNNING; // Set game state to running
-    currentPlayer = 'X'; // human first // Set current player to 'X' (human starts)
+    xToMove = true; // Human ('X') starts
+}
+
+void TicTacToe::resetSession() { // Start over for a new player
+    resetGame();
+    scoreHuman = 0; // Scores belong to the previous player
+    scoreCPU = 0;
+    opponent.reset(); // So does what the adaptive agent learned about them
+}
+
+void TicTacToe::drawBoard() const { // Draw the current state of the board on the console
+    drawBoard(cout);
 }
 
-void TicTacToe::drawBoard() const { // Draw the current state of the board
+void TicTacToe::drawBoard(std::ostream& out) const { // Draw the current state of the board
+    TTT_SCOPED_TIMER(Timer::Render);
     const char rowLabels[3] = {'A', 'B', 'C'};
-    cout << "\n    1   2   3\n"; // Print column headers (changed to 1 2 3)
+    out << "\n    1   2   3\n"; // Print column headers (changed to 1 2 3)
     for (int r = 0; r < 3; ++r) { // For each row
-        cout << "  -------------\n"; // Print horizontal line
-        cout << rowLabels[r] << " |"; // Print row label (A, B, C) and left border
+        out << "  -------------\n"; // Print horizontal line
+        out << rowLabels[r] << " |"; // Print row label (A, B, C) and left border
         for (int c = 0; c < 3; ++c) { // For each column
-            cout << " " << board[r][c] << " |"; // Print cell value and right border
+            out << " " << mark(r * 3 + c) << " |"; // Print cell value and right border
+        }
+        out << "\n"; // Newline at end of row
+    }
+    out << "  -------------\n\n"; // Print bottom border
+}
+
+void TicTacToe::drawAnalysis(std::ostream& out) const { // Board with every empty cell labelled by its value
+    TTT_SCOPED_TIMER(Timer::Render);
+    std::array<int, 9> values;
+    Solver::analyze(xMask, oMask, values); // Same cell layout as Solver; one pass over the table for all cells
+    const int marks = popcount64(xMask | oMask);
+
+    const char rowLabels[3] = {'A', 'B', 'C'};
+    out << "\n    1   2   3\n"; // Same frame as drawBoard
+    for (int r = 0; r < 3; ++r) {
+        out << "  -------------\n";
+        out << rowLabels[r] << " |";
+        for (int c = 0; c < 3; ++c) {
+            const int v = values[static_cast<size_t>(r * 3 + c)];
+            if (v == Solver::kUnreachable) { out << " " << mark(r * 3 + c) << " |"; continue; } // Taken cell
+            const int plies = Solver::pliesToEnd(v, marks);
+            if (v > 0) out << " W" << plies << "|";      // Win, game over in this many plies
+            else if (v < 0) out << " L" << plies << "|"; // Loss against best defence
+            else out << " D |";                          // Draw
         }
-        cout << "\n"; // Newline at end of row
+        out << "\n";
     }
-    cout << "  -------------\n\n"; // Print bottom border
+    out << "  -------------\n";
+    out << "  Wn/Ln: win/loss n plies from now (this move included), D: draw; both sides perfect\n\n";
 }
 
 bool TicTacToe::isAvailable(int row, int col) const { // Check if a cell is available
     if (row < 0 || row > 2 || col < 0 || col > 2) return false; // Out of bounds check
-    return board[row][col] == ' '; // Return true if cell is empty
+    return !(((xMask | oMask) >> (row * 3 + col)) & 1); // Return true if cell is empty
+}
+
+char TicTacToe::mark(int cell) const { // Character shown for a cell
+    if ((xMask >> cell) & 1) return 'X';
+    return ((oMask >> cell) & 1) ? 'O' : ' ';
 }
 
 bool TicTacToe::placeMark(int row, int col) { // Place the current player's mark on the board
     if (!isAvailable(row, col)) return false; // If cell is not available, return false
-    board[row][col] = currentPlayer; // Place the mark
+    std::uint16_t& mine = xToMove ? xMask : oMask;
+    mine = static_cast<std::uint16_t>(mine | (1u << (row * 3 + col))); // Place the mark
+    TTT_COUNT(Counter::Moves);
     return true; // Return true for successful placement
 }
 
 void TicTacToe::switchTurn() { // Switch the current player
-    currentPlayer = (currentPlayer == 'X') ? 'O' : 'X'; // Toggle between 'X' and 'O'
+    xToMove = !xToMove; // Toggle between 'X' and 'O'
 }
 
 GameState TicTacToe::evaluateBoard() const { // Evaluate the current board state
-    auto threeEqual = [&](char a, char b, char c, char who) { // Lambda to check if three cells are equal to 'who'
-        return (a == who && b == who && c == who);
-    };
-
-    for (int i = 0; i < 3; ++i) { // Check rows and columns for win
-        if (threeEqual(board[i][0], board[i][1], board[i][2], 'X')) return GameState::HUMAN_WIN; // Row win for X
-        if (threeEqual(board[i][0], board[i][1], board[i][2], 'O')) return GameState::CPU_WIN;   // Row win for O
-
-        if (threeEqual(board[0][i], board[1][i], board[2][i], 'X')) return GameState::HUMAN_WIN; // Column win for X
-        if (threeEqual(board[0][i], board[1][i], board[2][i], 'O')) return GameState::CPU_WIN;   // Column win for O
-    }
+    TTT_COUNT(Counter::Evaluations);
+    TTT_SCOPED_TIMER(Timer::EvaluateBoard);
+    return Rules<ClassicGeometry>::evaluate(xMask, oMask); // Unrolled line checks, X before O, then tie/running
+}
 
-    if (threeEqual(board[0][0], board[1][1], board[2][2], 'X')) return GameState::HUMAN_WIN; // Diagonal win for X
-    if (threeEqual(board[0][0], board[1][1], board[2][2], 'O')) return GameState::CPU_WIN;   // Diagonal win for O
-    if (threeEqual(board[0][2], board[1][1], board[2][0], 'X')) return GameState::HUMAN_WIN; // Anti-diagonal win for X
-    if (threeEqual(board[0][2], board[1][1], board[2][0], 'O')) return GameState::CPU_WIN;   // Anti-diagonal win for O
+template <char Side>
+void TicTacToe::play(int cell) { // The moves' own path: only the lines through cell can have changed
+    std::uint16_t& mine = Side == 'X' ? xMask : oMask;
+    mine = static_cast<std::uint16_t>(mine | (1u << cell));
+    TTT_COUNT(Counter::Moves);
+    state = Rules<ClassicGeometry>::afterMove<Side>(mine, static_cast<std::uint16_t>(xMask | oMask), cell);
+    if (state == GameState::RUNNING) xToMove = Side != 'X'; // Hand the turn to the other side
+}
 
-    for (const auto& row : board) // Check for any empty cells
-        for (char cell : row)
-            if (cell == ' ') return GameState::RUNNING; // Game still running if empty cell found
+void TicTacToe::play(int cell) { // The one runtime branch on the side; everything after it is per-side code
+    if (xToMove) play<'X'>(cell);
+    else play<'O'>(cell);
+}
 
-    return GameState::TIE; // No winner and no empty cells means tie
+bool TicTacToe::hasLine(std::uint16_t cells) { // Mask form of the win check
+    return Rules<ClassicGeometry>::hasLine(cells);
 }
 
 void TicTacToe::playerMove(int row, int col) { // Handle a move by the human player
     if (state != GameState::RUNNING) return; // Do nothing if game is not running
-    if (placeMark(row, col)) { // Try to place the mark
-        state = evaluateBoard(); // Update game state after move
-        if (state == GameState::RUNNING) switchTurn(); // If game still running, switch turn
-    } else {
-        std::cout << "Invalid move. Cell is taken or out of range.\n"; // Print error for invalid move
-    }
+    if (isAvailable(row, col)) play(row * 3 + col); // Mark the cell, update the state, pass the turn
+    else std::cout << "Invalid move. Cell is taken or out of range.\n"; // Print error for invalid move
 }
 
 void TicTacToe::computerMove() { // Handle a move by the computer player
     if (state != GameState::RUNNING) return; // Do nothing if game is not running
+    StartupProbe startup; // Times the first CPU move of the process (no-op otherwise)
+    MoveAllocProbe allocations; // Counts this move's heap allocations (no-op unless --alloc-profile)
+    TTT_SCOPED_TIMER(Timer::ComputerMove);
+    static const int latencySeries[3] = { // board size / difficulty, indexed by Difficulty
+        LatencyRecorder::series("3x3/random"),
+        LatencyRecorder::series("3x3/adaptive"),
+        LatencyRecorder::series("3x3/perfect"),
+    };
+    LatencyTimer latency(latencySeries[static_cast<int>(difficulty)]);
+
+    if (difficulty != Difficulty::RANDOM) { // Solved-table agent: precomputed move tiers, no search
+        int cell = opponent.chooseMove(xMask, oMask, difficulty == Difficulty::PERFECT);
+        if (cell < 0) return;
+        play(cell);
+        return;
+    }
 
-    std::vector<std::pair<int, int>> empty; // Vector to store empty cell positions
-    empty.reserve(9); // Reserve space for up to 9 positions
-    for (int r = 0; r < 3; ++r) // Iterate through rows
-        for (int c = 0; c < 3; ++c) // Iterate through columns
-            if (board[r][c] == ' ') empty.emplace_back(r, c); // Add empty cell to vector
+    std::uint64_t empty = kFullMask & ~(xMask | oMask); // Empty cells as a mask
+    const int emptyCount = popcount64(empty);
+    if (emptyCount == 0) return; // If no empty cells, return
 
-    if (empty.empty()) return; // If no empty cells, return
+    rng ^= rng << 13; // xorshift64 step
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    const auto pick = ((rng >> 32) * static_cast<std::uint64_t>(emptyCount)) >> 32; // Uniform index in [0, emptyCount)
 
-    static std::mt19937 rng(
-        static_cast<unsigned>(std::chrono::high_resolution_clock::now().time_since_epoch().count())); // Static random number generator seeded with current time
-    std::uniform_int_distribution<int> dist(0, static_cast<int>(empty.size()) - 1); // Distribution for picking a random empty cell
+    for (auto n = pick; n > 0; --n) empty &= empty - 1; // Drop the lower empty cells to reach the chosen one
+    play(lowestBit64(empty)); // Place the computer's mark, update the state, pass the turn
+}
 
-    auto [row, col] = empty[dist(rng)]; // Choose a random empty cell
-    placeMark(row, col); // Place the computer's mark
+void TicTacToe::setDifficulty(Difficulty level, double targetWinRate) { // Choose the CPU opponent
+    difficulty = level;
+    opponent.setTarget(targetWinRate);
+    if (level != Difficulty::RANDOM) AdaptiveAgent::prepare(); // Pay for the move tables now, not on the first move
+}
 
-    state = evaluateBoard(); // Update game state after move
-    if (state == GameState::RUNNING) switchTurn(); // If game still running, switch turn
+void TicTacToe::printResult() { // Print the result of the game on the console and update scores
+    printResult(cout);
 }
 
-void TicTacToe::printResult() { // Print the result of the game and update scores
+void TicTacToe::printResult(std::ostream& out) { // Print the result of the game and update scores
+    if (state != GameState::RUNNING) opponent.observe(state); // Opponent model learns from every finished round
     switch (state) { // Check game state
     case GameState::HUMAN_WIN: // If human wins
-        std::cout << "Human wins!\n"; ++scoreHuman; break; // Print message and increment human score
+        out << "Human wins!\n"; ++scoreHuman; break; // Print message and increment human score
     case GameState::CPU_WIN: // If computer wins
-        std::cout << "Computer wins!\n"; ++scoreCPU; break; // Print message and increment computer score
+        out << "Computer wins!\n"; ++scoreCPU; break; // Print message and increment computer score
     case GameState::TIE: // If tie
-        std::cout << "It's a tie!\n"; break; // Print tie message
+        out << "It's a tie!\n"; break; // Print tie message
     default: break; // No action for other states
     }
 }
 
-void TicTacToe::printScores() const { // Print the scores of both players
-    std::cout << "Human Score: " << scoreHuman
-              << " | Computer Score: " << scoreCPU << "\n"; // Print scores
+void TicTacToe::printScores() const { // Print the scores of both players on the console
+    printScores(cout);
+}
+
+void TicTacToe::printScores(std::ostream& out) const { // Print the scores of both players
+    out << "Human Score: " << scoreHuman
+        << " | Computer Score: " << scoreCPU << "\n"; // Print scores
 }
+
 // ──────────────────────────────────────────────────────────────
 // Label-to-index helpers (declared static in Driver.h)
 int TicTacToe::rowIndexFromLabel(char rowLabel) {
@@ -152,9 +238,10 @@ bool TicTacToe::placeMark(char rowLabel, int colLabel) {
 
 void TicTacToe::playerMove(char rowLabel, int colLabel) {
     if (state != GameState::RUNNING) return;
-    if (placeMark(rowLabel, colLabel)) {
-        state = evaluateBoard();
-        if (state == GameState::RUNNING) switchTurn();
+    const int r = rowIndexFromLabel(rowLabel);
+    const int c = colIndexFromLabel(colLabel);
+    if (r >= 0 && c >= 0 && isAvailable(r, c)) {
+        play(r * 3 + c);
     } else {
         std::cout << "Invalid move. Use rows A-C and columns 1-3, and choose an empty cell.\n";
     }
@@ -0,0 +1,218 @@
+#pragma once // Ensure the header is included only once during compilation
+#include "Arena.h"    // Per-thread scratch for the tree
+#include "Driver.h"   // GameState
+#include "Latency.h"  // Per-move latency series "<variant>/mcts"
+#include "Profiler.h" // Search node counter
+#include <array>
+#include <chrono>     // Move time budget
+#include <cmath>      // std::log / std::sqrt for UCT
+#include <cstdint>
+#include <functional> // Optional batched leaf evaluator
+#include <string>
+#include <vector>
+
+// Monte-Carlo tree search agent with UCT selection and random playouts,
+// bounded by a wall-clock budget per move. The tree lives in the calling
+// thread's Arena and is discarded in one rewind once the move is chosen.
+// With an evaluator set, expanding a leaf scores all of its children in one
+// batched call instead of playing out (each child starts with one visit at
+// that value) and the leaf backs up the best child's value.
+//
+// Board requirements (UltimateBoard, QubicBoard):
+//   static constexpr int kCells;            upper bound on legal moves
+//   static constexpr const char* kName;     latency series prefix
+//   int legalMoves(std::array<std::uint8_t, kCells>&) const;
+//   bool play(int move);
+//   GameState state() const;                HUMAN_WIN = X, CPU_WIN = O
+//   char sideToMove() const;
+template <class Board>
+class Mcts {
+public:
+    explicit Mcts(int budget = 100, std::uint64_t seed = 0) // Milliseconds per move; seed 0 = time-based
+        : budgetMs(budget > 0 ? budget : 1),
+          rngState(seed ? seed : static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) | 1) {}
+
+    // Values in [-1, 1] for each board's side to move.
+    using BatchEvaluator = std::function<void(const Board* boards, int count, float* out)>;
+
+    void setEvaluator(BatchEvaluator fn) { evaluator = std::move(fn); } // Empty: random playouts
+    void seed(std::uint64_t value) { rngState = value | 1; } // Replace the constructor's seed
+    void setBudget(int budget) { budgetMs = budget > 0 ? budget : 1; }
+    int chooseMove(const Board& board);                 // Best move for the side to move (-1 if none)
+    std::uint64_t lastIterations() const { return iterations; }
+
+private:
+    using MoveList = std::array<std::uint8_t, Board::kCells>;
+
+    struct Node {
+        std::int32_t parent = -1;
+        std::int32_t firstChild = -1;                   // Children are stored contiguously
+        std::uint8_t childCount = 0;
+        std::uint8_t move = 0;                          // Move that led here
+        bool expanded = false;
+        std::uint32_t visits = 0;
+        float wins = 0.0f;                              // From the perspective of the player who made `move`
+    };
+
+    int budgetMs;
+    std::uint64_t rngState;
+    std::uint64_t iterations = 0;
+    ArenaVector<Node> nodes;                            // Tree storage in this thread's arena, valid during chooseMove
+    BatchEvaluator evaluator;
+    std::vector<Board> leafBoards;                      // Evaluator batch scratch, reused across expansions
+    std::vector<std::int32_t> leafNodes;
+    std::vector<float> leafValues;
+
+    std::uint64_t nextRandom() { // xorshift64*: cheap enough to call once per playout move
+        rngState ^= rngState >> 12;
+        rngState ^= rngState << 25;
+        rngState ^= rngState >> 27;
+        return rngState * 0x2545F4914F6CDD1DULL;
+    }
+
+    int selectChild(const Node& node) const;
+    float playout(Board board, char perspective);       // 1 win, 0.5 draw, 0 loss for perspective
+    float seedChildren(int parent, const Board& board); // Evaluator path; returns the parent's value for its mover
+};
+
+template <class Board>
+int Mcts<Board>::selectChild(const Node& node) const { // UCT with exploration constant sqrt(2)
+    const double logParent = std::log(static_cast<double>(node.visits > 0 ? node.visits : 1));
+    int best = node.firstChild;
+    double bestScore = -1.0;
+    for (int i = 0; i < node.childCount; ++i) {
+        const Node& child = nodes[static_cast<size_t>(node.firstChild + i)];
+        if (child.visits == 0) return node.firstChild + i; // Try every child once first
+        double v = static_cast<double>(child.visits);
+        double score = child.wins / v + 1.41421356 * std::sqrt(logParent / v);
+        if (score > bestScore) {
+            bestScore = score;
+            best = node.firstChild + i;
+        }
+    }
+    return best;
+}
+
+template <class Board>
+float Mcts<Board>::playout(Board board, char perspective) {
+    MoveList moves;
+    while (board.state() == GameState::RUNNING) {
+        int n = board.legalMoves(moves);
+        board.play(moves[nextRandom() % static_cast<std::uint64_t>(n)]);
+    }
+    if (board.state() == GameState::TIE) return 0.5f;
+    char winner = (board.state() == GameState::HUMAN_WIN) ? 'X' : 'O';
+    return winner == perspective ? 1.0f : 0.0f;
+}
+
+template <class Board>
+float Mcts<Board>::seedChildren(int parent, const Board& board) {
+    const Node& p = nodes[static_cast<size_t>(parent)];
+    leafBoards.clear();
+    leafNodes.clear();
+    float best = 0.0f;
+    for (int i = 0; i < p.childCount; ++i) {
+        const std::int32_t c = p.firstChild + i;
+        Board child = board;
+        child.play(nodes[static_cast<size_t>(c)].move);
+        if (child.state() == GameState::RUNNING) {
+            leafBoards.push_back(child);
+            leafNodes.push_back(c);
+            continue;
+        }
+        float v = child.state() == GameState::TIE ? 0.5f : 1.0f; // Decided by this move: a tie or a win for the mover
+        nodes[static_cast<size_t>(c)].visits = 1;
+        nodes[static_cast<size_t>(c)].wins = v;
+        if (v > best) best = v;
+    }
+    leafValues.resize(leafBoards.size());
+    if (!leafBoards.empty()) evaluator(leafBoards.data(), static_cast<int>(leafBoards.size()), leafValues.data());
+    for (size_t k = 0; k < leafNodes.size(); ++k) {
+        float v = (1.0f - leafValues[k]) * 0.5f; // Network scores the child's side to move; flip to the mover, map to [0, 1]
+        Node& child = nodes[static_cast<size_t>(leafNodes[k])];
+        child.visits = 1;
+        child.wins = v;
+        if (v > best) best = v;
+    }
+    return 1.0f - best;
+}
+
+template <class Board>
+int Mcts<Board>::chooseMove(const Board& root) {
+    static const int latencySeries = LatencyRecorder::series((std::string(Board::kName) + "/mcts").c_str());
+    LatencyTimer latency(latencySeries);
+
+    MoveList moves;
+    int rootMoves = root.legalMoves(moves);
+    if (rootMoves == 0) return -1;
+    if (rootMoves == 1) return moves[0];
+
+    Arena& arena = Arena::local();
+    ArenaScope scratch(arena); // The whole tree is dropped in one rewind when the move is chosen
+    nodes.reset(arena, 4096);
+    nodes.push_back(Node{}); // Root
+    iterations = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(budgetMs);
+
+    do {
+        for (int batch = 0; batch < 64; ++batch, ++iterations) { // Check the clock every 64 iterations
+            Board board = root;
+            int n = 0;
+            float result = 0.0f;
+            bool evaluated = false;                     // Leaf value came from the evaluator
+
+            // Selection: descend through expanded nodes
+            while (nodes[static_cast<size_t>(n)].expanded && nodes[static_cast<size_t>(n)].childCount) {
+                n = selectChild(nodes[static_cast<size_t>(n)]);
+                board.play(nodes[static_cast<size_t>(n)].move);
+            }
+
+            // Expansion: leaves grow children on their second visit (the root immediately)
+            if (!nodes[static_cast<size_t>(n)].expanded && board.state() == GameState::RUNNING &&
+                (n == 0 || nodes[static_cast<size_t>(n)].visits > 0)) {
+                int count = board.legalMoves(moves);
+                int first = static_cast<int>(nodes.size());
+                for (int i = 0; i < count; ++i) {
+                    Node child;
+                    child.parent = n;
+                    child.move = moves[static_cast<size_t>(i)];
+                    nodes.push_back(child);
+                }
+                Node& leaf = nodes[static_cast<size_t>(n)];
+                leaf.expanded = true;
+                leaf.firstChild = first;
+                leaf.childCount = static_cast<std::uint8_t>(count);
+                if (evaluator) {
+                    result = seedChildren(n, board);
+                    evaluated = true;
+                } else {
+                    n = first + static_cast<int>(nextRandom() % static_cast<std::uint64_t>(count));
+                    board.play(nodes[static_cast<size_t>(n)].move);
+                }
+            }
+
+            // Simulation from the perspective of the player who moved into n
+            if (!evaluated) {
+                char mover = (board.sideToMove() == 'X') ? 'O' : 'X';
+                result = playout(board, mover);
+            }
+
+            // Backpropagation, flipping perspective at each ply
+            while (n != -1) {
+                Node& node = nodes[static_cast<size_t>(n)];
+                ++node.visits;
+                node.wins += result;
+                result = 1.0f - result;
+                n = node.parent;
+            }
+        }
+    } while (std::chrono::steady_clock::now() < deadline);
+    TTT_COUNT_N(Counter::SearchNodes, iterations);
+
+    const Node& rootNode = nodes[0];
+    int best = rootNode.firstChild;
+    for (int i = 0; i < rootNode.childCount; ++i) // Most-visited child is the robust choice
+        if (nodes[static_cast<size_t>(rootNode.firstChild + i)].visits > nodes[static_cast<size_t>(best)].visits)
+            best = rootNode.firstChild + i;
+    return nodes[static_cast<size_t>(best)].move;
+}
@@ -0,0 +1,256 @@
+#include "MoveCache.h" // Move cache declarations
+#include "AllocProfile.h" // Warm-start reads are charged to the cache tag
+#include "Bits.h"      // lowestBit64
+#include "Profiler.h"  // TTHits / CacheMisses counters
+#include <algorithm>   // std::next_permutation, std::min
+#include <array>
+#include <bit>         // std::endian for the file layout
+#include <cstring>     // std::memcmp for the file magic
+#include <filesystem>  // Atomic replace of the saved file
+#include <fstream>
+#include <new>         // std::bad_alloc
+#include <ostream>
+#include <vector>      // Entries staged until the whole file validates
+
+namespace {
+constexpr char kMagic[4] = {'T', 'T', 'T', 'C'};
+static_assert(std::endian::native == std::endian::little, "TTTC files are little-endian; load/save copy fields as they are in memory");
+
+// The cube's 48 symmetries as cell permutations: permute the three axes,
+// then optionally mirror each one. Every one of them maps lines onto lines.
+// Computed by the compiler into read-only data.
+struct CubeSymmetries {
+    std::array<std::array<std::uint8_t, 64>, 48> forward{}; // cell -> image
+    std::array<std::array<std::uint8_t, 64>, 48> inverse{}; // image -> cell
+
+    constexpr CubeSymmetries() {
+        std::array<int, 3> axes = {0, 1, 2};
+        int s = 0;
+        do {
+            for (int flips = 0; flips < 8; ++flips, ++s) {
+                for (int cell = 0; cell < 64; ++cell) {
+                    const int coord[3] = {cell / 16, (cell / 4) % 4, cell % 4};
+                    int image = 0;
+                    for (int i = 0; i < 3; ++i) {
+                        int c = coord[axes[static_cast<size_t>(i)]];
+                        if ((flips >> i) & 1) c = 3 - c;
+                        image = image * 4 + c;
+                    }
+                    forward[static_cast<size_t>(s)][static_cast<size_t>(cell)] = static_cast<std::uint8_t>(image);
+                    inverse[static_cast<size_t>(s)][static_cast<size_t>(image)] = static_cast<std::uint8_t>(cell);
+                }
+            }
+        } while (std::next_permutation(axes.begin(), axes.end()));
+    }
+};
+
+constexpr CubeSymmetries kCube{};
+
+std::uint64_t transform(const std::array<std::uint8_t, 64>& perm, std::uint64_t mask) {
+    std::uint64_t out = 0;
+    for (; mask; mask &= mask - 1) out |= 1ULL << perm[static_cast<size_t>(lowestBit64(mask))];
+    return out;
+}
+
+// Canonical (x, o) and the symmetry that produced it.
+int canonicalize(const QubicBoard& board, std::uint64_t& x, std::uint64_t& o) {
+    const CubeSymmetries& sym = kCube;
+    x = board.marks('X');
+    o = board.marks('O');
+    int best = 0; // Symmetry 0 is the identity
+    for (int s = 1; s < 48; ++s) {
+        const std::uint64_t tx = transform(sym.forward[static_cast<size_t>(s)], board.marks('X'));
+        if (tx > x) continue;
+        const std::uint64_t to = transform(sym.forward[static_cast<size_t>(s)], board.marks('O'));
+        if (tx < x || to < o) {
+            x = tx;
+            o = to;
+            best = s;
+        }
+    }
+    return best;
+}
+
+std::uint64_t mix(std::uint64_t v) { // splitmix64 finalizer
+    v ^= v >> 30;
+    v *= 0xbf58476d1ce4e5b9ULL;
+    v ^= v >> 27;
+    v *= 0x94d049bb133111ebULL;
+    return v ^ (v >> 31);
+}
+} // namespace
+
+MoveCache::MoveCache(std::size_t budgetBytes) {
+    length = 64;
+    while (length * 2 * sizeof(Slot) <= budgetBytes) length *= 2;
+    slots.reset(static_cast<Slot*>(std::calloc(length, sizeof(Slot))));
+    if (!slots) throw std::bad_alloc();
+    mask = length - 1;
+    maxEntries = length / 2; // Short probe chains
+}
+
+std::size_t MoveCache::home(std::uint64_t x, std::uint64_t o, std::uint8_t tag) const {
+    return static_cast<std::size_t>(mix(x ^ mix(o ^ tag))) & mask;
+}
+
+std::size_t MoveCache::find(std::uint64_t x, std::uint64_t o, std::uint8_t tag) const {
+    for (std::size_t i = home(x, o, tag);; i = (i + 1) & mask) {
+        const Slot& s = slots[i];
+        if (!(s.flags & kUsed)) return length;
+        if (s.x == x && s.o == o && s.tag == tag) return i;
+    }
+}
+
+bool MoveCache::lookup(const QubicBoard& board, std::uint8_t tag, CachedMove& out) {
+    std::uint64_t x, o;
+    const int sym = canonicalize(board, x, o);
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::size_t i = find(x, o, tag);
+    if (i == length) {
+        missCount.fetch_add(1, std::memory_order_relaxed);
+        TTT_COUNT(Counter::CacheMisses);
+        return false;
+    }
+    Slot& s = slots[i];
+    s.ref = std::max<std::uint8_t>(s.ref, (s.flags & kProven) ? 3 : 1);
+    out.move = kCube.inverse[static_cast<size_t>(sym)][s.move];
+    out.value = s.value;
+    out.proven = (s.flags & kProven) != 0;
+    hitCount.fetch_add(1, std::memory_order_relaxed);
+    TTT_COUNT(Counter::TTHits);
+    return true;
+}
+
+void MoveCache::store(const QubicBoard& board, std::uint8_t tag, const CachedMove& entry) {
+    if (entry.move < 0 || entry.move >= 64) return;
+    Slot slot;
+    const int sym = canonicalize(board, slot.x, slot.o);
+    slot.move = kCube.forward[static_cast<size_t>(sym)][static_cast<size_t>(entry.move)];
+    slot.value = entry.value;
+    slot.tag = tag;
+    slot.flags = static_cast<std::uint8_t>(kUsed | (entry.proven ? kProven : 0));
+    slot.ref = entry.proven ? 3 : 1;
+    std::lock_guard<std::mutex> lock(mutex);
+    insert(slot);
+}
+
+void MoveCache::insert(const Slot& slot) {
+    const std::size_t existing = find(slot.x, slot.o, slot.tag);
+    if (existing != length) {
+        slots[existing] = slot; // A newer search of the same position replaces the old answer
+        return;
+    }
+    if (entries >= maxEntries) evictOne();
+    std::size_t i = home(slot.x, slot.o, slot.tag);
+    while (slots[i].flags & kUsed) i = (i + 1) & mask;
+    slots[i] = slot;
+    ++entries;
+}
+
+void MoveCache::evictOne() {
+    for (;; hand = (hand + 1) & mask) {
+        Slot& s = slots[hand];
+        if (!(s.flags & kUsed)) continue;
+        if (s.ref > 0) {
+            --s.ref; // Second chance
+            continue;
+        }
+        erase(hand);
+        evictCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+}
+
+void MoveCache::erase(std::size_t index) {
+    std::size_t hole = index;
+    for (std::size_t j = (hole + 1) & mask; slots[j].flags & kUsed; j = (j + 1) & mask) {
+        const std::size_t h = home(slots[j].x, slots[j].o, slots[j].tag);
+        const bool stays = hole <= j ? (h > hole && h <= j) : (h > hole || h <= j); // Home lies in (hole, j]
+        if (!stays) {
+            slots[hole] = slots[j];
+            hole = j;
+        }
+    }
+    slots[hole] = Slot{};
+    --entries;
+}
+
+std::size_t MoveCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries;
+}
+
+// File layout: "TTTC", uint32 count, then count records of
+// x, o (uint64), value (int32), move, tag, proven (uint8), little-endian
+// (fields are copied as-is, so only little-endian hosts build; see kMagic).
+bool MoveCache::load(const std::string& path, std::string& error) {
+    AllocScope scope(AllocTag::Cache);
+    std::ifstream in(path, std::ios::binary);
+    if (!in) { error = path + ": cannot open"; return false; }
+    char magic[4];
+    std::uint32_t count = 0;
+    if (!in.read(magic, 4) || std::memcmp(magic, kMagic, 4) != 0) { error = path + ": not a TTTC move cache"; return false; }
+    if (!in.read(reinterpret_cast<char*>(&count), sizeof count)) { error = path + ": truncated header"; return false; }
+    std::vector<Slot> staged; // A bad file must leave the table untouched
+    staged.reserve(std::min<std::size_t>(count, maxEntries));
+    for (std::uint32_t n = 0; n < count; ++n) {
+        Slot slot;
+        std::uint8_t proven = 0;
+        if (!in.read(reinterpret_cast<char*>(&slot.x), sizeof slot.x) || !in.read(reinterpret_cast<char*>(&slot.o), sizeof slot.o) ||
+            !in.read(reinterpret_cast<char*>(&slot.value), sizeof slot.value) || !in.read(reinterpret_cast<char*>(&slot.move), 1) ||
+            !in.read(reinterpret_cast<char*>(&slot.tag), 1) || !in.read(reinterpret_cast<char*>(&proven), 1)) {
+            error = path + ": truncated after " + std::to_string(n) + " entries";
+            return false;
+        }
+        if (slot.move >= 64 || (slot.x & slot.o)) { error = path + ": corrupt entry " + std::to_string(n); return false; }
+        slot.flags = static_cast<std::uint8_t>(kUsed | (proven ? kProven : 0));
+        slot.ref = 0; // Warm entries earn their place through hits
+        staged.push_back(slot);
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const Slot& slot : staged) insert(slot);
+    return true;
+}
+
+// Written to PATH.tmp and renamed over PATH, so a crash mid-write leaves the old file intact.
+bool MoveCache::save(const std::string& path) const {
+    const std::string tmp = path + ".tmp";
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    bool ok = out && write(out);
+    out.close();
+    if (!ok || out.fail()) {
+        std::error_code ignored;
+        std::filesystem::remove(tmp, ignored);
+        return false;
+    }
+    std::error_code renameError;
+    std::filesystem::rename(tmp, path, renameError);
+    return !renameError;
+}
+
+bool MoveCache::write(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto count = static_cast<std::uint32_t>(entries);
+    out.write(kMagic, 4);
+    out.write(reinterpret_cast<const char*>(&count), sizeof count);
+    for (std::size_t i = 0; i < length; ++i) {
+        const Slot& s = slots[i];
+        if (!(s.flags & kUsed)) continue;
+        const std::uint8_t proven = (s.flags & kProven) ? 1 : 0;
+        out.write(reinterpret_cast<const char*>(&s.x), sizeof s.x);
+        out.write(reinterpret_cast<const char*>(&s.o), sizeof s.o);
+        out.write(reinterpret_cast<const char*>(&s.value), sizeof s.value);
+        out.write(reinterpret_cast<const char*>(&s.move), 1);
+        out.write(reinterpret_cast<const char*>(&s.tag), 1);
+        out.write(reinterpret_cast<const char*>(&proven), 1);
+    }
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+void MoveCache::printStats(std::ostream& out) const {
+    const std::uint64_t lookups = hits() + misses();
+    out << "Move cache: " << hits() << " hits / " << lookups << " lookups ("
+        << (lookups ? 100.0 * static_cast<double>(hits()) / static_cast<double>(lookups) : 0.0) << "%), "
+        << size() << "/" << capacity() << " entries, " << evictions() << " evictions\n";
+}
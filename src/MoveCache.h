@@ -0,0 +1,89 @@
+#pragma once // Ensure the header is included only once during compilation
+#include "QubicBoard.h" // Cached positions
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>      // std::free for the calloc'd table
+#include <iosfwd>       // std::ostream forward declaration
+#include <memory>
+#include <mutex>
+#include <string>
+
+// One remembered reply.
+struct CachedMove {
+    int move = -1;       // Cell for the position as given (not the canonical one)
+    int value = 0;       // Search score for the side to move (0 when the agent has none)
+    bool proven = false; // Value is a forced result; the entry never goes stale
+};
+
+// Bounded position -> reply cache in front of the Qubic agents.
+//
+// Players repeat the same openings, and each of those replies costs a full
+// search budget. Positions are keyed in canonical form: the smallest (x, o)
+// mask pair over the cube's 48 rotations and reflections. So an opening
+// played in any orientation hits the same entry. Moves are stored in the
+// canonical frame and mapped back on lookup.
+//
+// The table is one open-addressing array sized from a byte budget and kept
+// at most half full. When it is full, a CLOCK hand picks the victim. A hit
+// sets an entry's reference count to 1. Proven results (forced wins and
+// losses, mostly from the endgame) start at 3, so they survive three sweeps
+// of the hand. Those are the costliest searches, and their answers never
+// change.
+//
+// The table comes from calloc, so a large budget costs nothing at startup:
+// the OS hands out zero pages as entries first land on them.
+//
+// Every call takes a mutex. The cache is shared by all sessions of a
+// server, and the lock costs nothing next to the search it saves.
+class MoveCache {
+public:
+    explicit MoveCache(std::size_t budgetBytes);
+
+    bool lookup(const QubicBoard& board, std::uint8_t tag, CachedMove& out); // tag separates agents/evaluators
+    void store(const QubicBoard& board, std::uint8_t tag, const CachedMove& entry);
+
+    bool load(const std::string& path, std::string& error); // Warm start ("TTTC" file); merges into the table
+    bool save(const std::string& path) const;
+
+    std::size_t size() const;
+    std::size_t capacity() const { return maxEntries; }
+    std::size_t tableBytes() const { return length * sizeof(Slot); } // calloc'd, so outside operator new accounting
+    std::uint64_t hits() const { return hitCount.load(std::memory_order_relaxed); }
+    std::uint64_t misses() const { return missCount.load(std::memory_order_relaxed); }
+    std::uint64_t evictions() const { return evictCount.load(std::memory_order_relaxed); }
+    void printStats(std::ostream& out) const;
+
+private:
+    struct Slot {
+        std::uint64_t x = 0;   // Canonical masks
+        std::uint64_t o = 0;
+        std::int32_t value = 0;
+        std::uint8_t move = 0; // Canonical cell
+        std::uint8_t tag = 0;
+        std::uint8_t flags = 0; // kUsed | kProven
+        std::uint8_t ref = 0;   // CLOCK reference count
+    };
+    static constexpr std::uint8_t kUsed = 1;
+    static constexpr std::uint8_t kProven = 2;
+
+    struct Free {
+        void operator()(Slot* p) const { std::free(p); }
+    };
+
+    mutable std::mutex mutex;
+    std::unique_ptr<Slot[], Free> slots; // All-zero bytes are empty slots
+    std::size_t length = 0;   // Power of two
+    std::size_t mask = 0;
+    std::size_t maxEntries = 0;
+    std::size_t entries = 0;
+    std::size_t hand = 0;     // CLOCK position
+    std::atomic<std::uint64_t> hitCount{0}, missCount{0}, evictCount{0};
+
+    std::size_t home(std::uint64_t x, std::uint64_t o, std::uint8_t tag) const;
+    std::size_t find(std::uint64_t x, std::uint64_t o, std::uint8_t tag) const; // Slot index, or length
+    void insert(const Slot& slot);      // Caller holds the lock
+    void evictOne();
+    void erase(std::size_t index);      // Backward-shift deletion keeps probe chains intact
+    bool write(std::ostream& out) const; // File body for save()
+};
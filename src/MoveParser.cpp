@@ -0,0 +1,147 @@
+#include "MoveParser.h" // Scanner and line reader declarations
+#include <cstring>      // std::memchr / std::memmove
+
+#if defined(_WIN32)
+#include <io.h>         // _read
+#else
+#include <cerrno>
+#include <unistd.h>     // read
+#endif
+
+namespace {
+// Cursor over a line; every helper advances p past what it accepted.
+struct Scanner {
+    const char* p;
+    const char* e;
+
+    void skipSeparators() { while (p < e && (*p == ' ' || *p == '\t' || *p == ',')) ++p; }
+    bool atEnd() { skipSeparators(); return p == e; }
+    bool digit() const { return p < e && *p >= '0' && *p <= '9'; }
+    bool letter() const { return p < e && ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z')); }
+
+    int number() { // Caller checked digit(); saturates instead of overflowing
+        int v = 0;
+        while (digit()) {
+            if (v < 1000) v = v * 10 + (*p - '0');
+            ++p;
+        }
+        return v;
+    }
+
+    int upper() { // Caller checked letter()
+        char c = *p++;
+        return c >= 'a' ? c - 'a' + 'A' : c;
+    }
+};
+
+Scanner scan(std::string_view line) { return {line.data(), line.data() + line.size()}; }
+} // namespace
+
+ParsedMove MoveParser::classic(std::string_view line) {
+    Scanner s = scan(line);
+    if (s.atEnd()) return {ParseStatus::EMPTY, -1};
+
+    if (s.digit()) { // Bare cell number
+        int n = s.number();
+        if (!s.atEnd()) return {ParseStatus::SYNTAX, -1};
+        if (n < 1 || n > 9) return {ParseStatus::RANGE, -1};
+        return {ParseStatus::OK, n - 1};
+    }
+    if (!s.letter()) return {ParseStatus::SYNTAX, -1};
+    int row = s.upper() - 'A';
+    s.skipSeparators();
+    if (!s.digit()) return {ParseStatus::SYNTAX, -1};
+    int col = s.number() - 1;
+    if (!s.atEnd()) return {ParseStatus::SYNTAX, -1};
+    if (row < 0 || row > 2 || col < 0 || col > 2) return {ParseStatus::RANGE, -1};
+    return {ParseStatus::OK, row * 3 + col};
+}
+
+ParsedMove MoveParser::qubic(std::string_view line) {
+    Scanner s = scan(line);
+    if (s.atEnd()) return {ParseStatus::EMPTY, -1};
+    if (!s.digit()) return {ParseStatus::SYNTAX, -1};
+
+    int first = s.number();
+    if (s.atEnd()) { // Bare cell number
+        if (first < 1 || first > 64) return {ParseStatus::RANGE, -1};
+        return {ParseStatus::OK, first - 1};
+    }
+    if (!s.letter()) return {ParseStatus::SYNTAX, -1};
+    int row = s.upper() - 'A';
+    s.skipSeparators();
+    if (!s.digit()) return {ParseStatus::SYNTAX, -1};
+    int col = s.number() - 1;
+    if (!s.atEnd()) return {ParseStatus::SYNTAX, -1};
+    int layer = first - 1;
+    if (layer < 0 || layer > 3 || row < 0 || row > 3 || col < 0 || col > 3) return {ParseStatus::RANGE, -1};
+    return {ParseStatus::OK, layer * 16 + row * 4 + col};
+}
+
+bool MoveParser::yes(std::string_view line) {
+    Scanner s = scan(line);
+    while (s.p < s.e && (*s.p == ' ' || *s.p == '\t')) ++s.p;
+    return s.p < s.e && (*s.p == 'y' || *s.p == 'Y');
+}
+
+const char* MoveParser::classicError(ParseStatus status) {
+    if (status == ParseStatus::RANGE) return "Out of range. Use rows A, B, C and columns 1, 2, 3.\n";
+    return "Invalid input. Please enter a row letter (A-C) and a column number (1-3).\n";
+}
+
+const char* MoveParser::qubicError(ParseStatus status) {
+    if (status == ParseStatus::RANGE) return "Out of range. Use layers 1-4, rows A-D and columns 1-4.\n";
+    return "Invalid input. Please enter a layer number, a row letter and a column number.\n";
+}
+
+LineReader::LineReader(int inputFd, std::size_t chunkSize) : fd(inputFd), buffer(chunkSize) {}
+
+std::optional<std::string_view> LineReader::next() {
+    for (;;) {
+        const char* base = buffer.data();
+        const void* nl = std::memchr(base + begin + scanned, '\n', end - begin - scanned);
+        if (nl) {
+            std::size_t stop = static_cast<std::size_t>(static_cast<const char*>(nl) - base);
+            std::size_t len = stop - begin;
+            if (len > 0 && base[stop - 1] == '\r') --len;
+            std::string_view line(base + begin, len);
+            begin = stop + 1;
+            scanned = 0;
+            return line;
+        }
+        scanned = end - begin;
+        if (!fill()) { // Final unterminated line, then nothing
+            if (begin == end) return std::nullopt;
+            std::string_view line(buffer.data() + begin, end - begin); // fill() may have moved the buffer
+            begin = end;
+            scanned = 0;
+            return line;
+        }
+    }
+}
+
+bool LineReader::fill() {
+    if (eof) return false;
+    if (end == buffer.size()) { // Make room: slide the partial line to the front, or grow for a huge line
+        if (begin == 0) buffer.resize(buffer.size() * 2);
+        else {
+            std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+            end -= begin;
+            begin = 0;
+        }
+    }
+    for (;;) {
+#if defined(_WIN32)
+        int n = _read(fd, buffer.data() + end, static_cast<unsigned>(buffer.size() - end));
+#else
+        ssize_t n = ::read(fd, buffer.data() + end, buffer.size() - end);
+        if (n < 0 && errno == EINTR) continue;
+#endif
+        if (n <= 0) {
+            eof = true;
+            return false;
+        }
+        end += static_cast<std::size_t>(n);
+        return true;
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// Outcome of scanning one line of move input.
+enum class ParseStatus {
+    OK,     // cell is valid
+    EMPTY,  // Blank line
+    SYNTAX, // Not shaped like a move
+    RANGE,  // Shaped like a move, but off the board
+};
+
+struct ParsedMove {
+    ParseStatus status = ParseStatus::EMPTY;
+    int cell = -1; // Classic: row * 3 + col. Qubic: layer * 16 + row * 4 + col
+};
+
+// Hand-written scanners over one input line. They do no allocation, use no
+// locale or stream state, and treat trailing junk as an error rather than
+// leaving it for the next prompt.
+//
+//   classic: "B 2", "b2", "B,2", or a cell number 1-9 in reading order (A1 = 1, C3 = 9)
+//   qubic:   "2 B 3", "2b3", "2,B,3", or a cell number 1-64 (layer-major)
+class MoveParser {
+public:
+    static ParsedMove classic(std::string_view line);
+    static ParsedMove qubic(std::string_view line);
+    static bool yes(std::string_view line);                 // First non-blank character is y/Y
+    static const char* classicError(ParseStatus status);    // Message for a rejected classic line
+    static const char* qubicError(ParseStatus status);
+};
+
+// Splits a file descriptor into lines by reading large chunks. next() hands
+// back a view into the internal buffer, with no trailing '\n' or '\r'. The
+// view stays valid until the following call. Data is only moved when a line
+// straddles the end of the buffer, and the buffer grows only for a line
+// longer than the chunk size.
+class LineReader {
+public:
+    explicit LineReader(int fd, std::size_t chunkSize = 64 * 1024);
+    std::optional<std::string_view> next(); // nullopt once input is exhausted
+
+private:
+    int fd;
+    std::vector<char> buffer;
+    std::size_t begin = 0; // Start of unconsumed bytes
+    std::size_t end = 0;   // End of bytes read so far
+    std::size_t scanned = 0; // Bytes past begin already searched for '\n'
+    bool eof = false;
+
+    bool fill(); // Read more input after end; false at end of input
+};
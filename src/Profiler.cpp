@@ -0,0 +1,119 @@
+#include "Profiler.h" // Counter/timer declarations
+#include <iomanip>    // Column formatting for the text dump
+#include <memory>     // std::unique_ptr owning each thread's block
+#include <mutex>      // Guards the block registry
+#include <ostream>
+#include <vector>
+
+namespace {
+constexpr int kCounters = static_cast<int>(Counter::Count);
+constexpr int kTimers = static_cast<int>(Timer::Count);
+
+// Every block ever handed out. Blocks are never freed so counts from finished
+// threads stay in the aggregate and late dumps never read dangling memory.
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ProfileBlock>> blocks;
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+// Snapshot of every block summed together.
+struct Totals {
+    std::uint64_t counters[kCounters]{};
+    std::uint64_t timerNanos[kTimers]{};
+    std::uint64_t timerCalls[kTimers]{};
+};
+
+Totals collect() {
+    Totals t;
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto& b : r.blocks) {
+        for (int i = 0; i < kCounters; ++i) t.counters[i] += b->counters[i].load(std::memory_order_relaxed);
+        for (int i = 0; i < kTimers; ++i) {
+            t.timerNanos[i] += b->timerNanos[i].load(std::memory_order_relaxed);
+            t.timerCalls[i] += b->timerCalls[i].load(std::memory_order_relaxed);
+        }
+    }
+    return t;
+}
+} // namespace
+
+ProfileBlock* Profiler::registerThread() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.blocks.push_back(std::make_unique<ProfileBlock>());
+    return r.blocks.back().get();
+}
+
+const char* Profiler::name(Counter c) {
+    switch (c) {
+    case Counter::Moves:       return "moves";
+    case Counter::Evaluations: return "evaluations";
+    case Counter::SearchNodes: return "search_nodes";
+    case Counter::TTHits:      return "tt_hits";
+    case Counter::CacheMisses: return "cache_misses";
+    default:                   return "?";
+    }
+}
+
+const char* Profiler::name(Timer t) {
+    switch (t) {
+    case Timer::ComputerMove:  return "computer_move";
+    case Timer::EvaluateBoard: return "evaluate_board";
+    case Timer::Render:        return "render";
+    default:                   return "?";
+    }
+}
+
+std::uint64_t Profiler::total(Counter c) {
+    return collect().counters[static_cast<int>(c)];
+}
+
+void Profiler::reset() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto& b : r.blocks) {
+        for (auto& v : b->counters) v.store(0, std::memory_order_relaxed);
+        for (auto& v : b->timerNanos) v.store(0, std::memory_order_relaxed);
+        for (auto& v : b->timerCalls) v.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::dumpText(std::ostream& out) {
+    if (!enabled()) {
+        out << "Profiling is disabled (configure with -DTICTACTOE_PROFILE=ON).\n";
+        return;
+    }
+    Totals t = collect();
+    out << "---- counters ----\n";
+    for (int i = 0; i < kCounters; ++i)
+        out << std::left << std::setw(16) << name(static_cast<Counter>(i))
+            << std::right << std::setw(14) << t.counters[i] << "\n";
+    out << "---- timers ----\n";
+    for (int i = 0; i < kTimers; ++i) {
+        double ms = static_cast<double>(t.timerNanos[i]) / 1e6;
+        double avgNs = t.timerCalls[i] ? static_cast<double>(t.timerNanos[i]) / static_cast<double>(t.timerCalls[i]) : 0.0;
+        out << std::left << std::setw(16) << name(static_cast<Timer>(i))
+            << std::right << std::setw(10) << t.timerCalls[i] << " calls "
+            << std::fixed << std::setprecision(3) << std::setw(12) << ms << " ms "
+            << std::setprecision(1) << std::setw(10) << avgNs << " ns/call\n";
+    }
+    out.unsetf(std::ios::floatfield);
+}
+
+void Profiler::dumpJson(std::ostream& out) {
+    Totals t = collect();
+    out << "{\"enabled\":" << (enabled() ? "true" : "false") << ",\"counters\":{";
+    for (int i = 0; i < kCounters; ++i)
+        out << (i ? "," : "") << '"' << name(static_cast<Counter>(i)) << "\":" << t.counters[i];
+    out << "},\"timers\":{";
+    for (int i = 0; i < kTimers; ++i)
+        out << (i ? "," : "") << '"' << name(static_cast<Timer>(i)) << "\":{\"calls\":" << t.timerCalls[i]
+            << ",\"nanos\":" << t.timerNanos[i] << "}";
+    out << "}}\n";
+}
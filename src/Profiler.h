@@ -0,0 +1,109 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <atomic>   // Relaxed atomics so a dump can read other threads' blocks safely
+#include <chrono>   // steady_clock for scoped timers
+#include <cstdint>  // Fixed-width counter types
+#include <iosfwd>   // std::ostream forward declaration for the dump functions
+
+// Hot-path instrumentation.
+//
+// Counters and timers are compiled in only when TICTACTOE_PROFILE is defined
+// (CMake option of the same name). Without it the TTT_COUNT / TTT_SCOPED_TIMER
+// macros expand to nothing and the engine carries no profiling cost at all.
+// With it, every thread increments its own block (single writer, no locked
+// instructions); Profiler::dumpText / dumpJson sum all blocks on demand.
+
+// Event counters recorded on the hot path.
+enum class Counter {
+    Moves,          // Marks placed on the board (human and CPU)
+    Evaluations,    // Full board evaluations (evaluateBoard and friends)
+    SearchNodes,    // Positions visited by the search agents
+    TTHits,         // Position/move-cache lookups that found an entry
+    CacheMisses,    // Position/move-cache lookups that found nothing
+    Count           // Number of counters (keep last)
+};
+
+// Scoped timers: accumulated wall time and number of scopes entered.
+enum class Timer {
+    ComputerMove,   // TicTacToe::computerMove
+    EvaluateBoard,  // TicTacToe::evaluateBoard
+    Render,         // Board rendering (drawBoard)
+    Count           // Number of timers (keep last)
+};
+
+// One thread's worth of counters. Only the owning thread writes; readers use relaxed loads.
+struct ProfileBlock {
+    std::atomic<std::uint64_t> counters[static_cast<int>(Counter::Count)]{};
+    std::atomic<std::uint64_t> timerNanos[static_cast<int>(Timer::Count)]{};
+    std::atomic<std::uint64_t> timerCalls[static_cast<int>(Timer::Count)]{};
+};
+
+class Profiler {
+public:
+    static constexpr bool enabled() { // True when the instrumentation is compiled in
+#ifdef TICTACTOE_PROFILE
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static const char* name(Counter c);         // Stable identifier used in both dump formats
+    static const char* name(Timer t);
+
+    static std::uint64_t total(Counter c);      // Sum of a counter over every thread seen so far
+    static void dumpText(std::ostream& out);    // Human-readable table
+    static void dumpJson(std::ostream& out);    // {"counters":{...},"timers":{...}}
+    static void reset();                        // Zero every block (e.g. between benchmark phases)
+
+    // Calling thread's block; registered with the aggregator on first use.
+    static ProfileBlock& local() {
+        thread_local ProfileBlock* block = registerThread();
+        return *block;
+    }
+
+    static void add(Counter c, std::uint64_t n = 1) { // Single-writer increment (no lock prefix)
+        auto& slot = local().counters[static_cast<int>(c)];
+        slot.store(slot.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    static void addTime(Timer t, std::uint64_t nanos) {
+        ProfileBlock& b = local();
+        auto& ns = b.timerNanos[static_cast<int>(t)];
+        auto& calls = b.timerCalls[static_cast<int>(t)];
+        ns.store(ns.load(std::memory_order_relaxed) + nanos, std::memory_order_relaxed);
+        calls.store(calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+private:
+    static ProfileBlock* registerThread();      // Allocates a block that outlives the thread
+};
+
+// RAII timer: charges the enclosing scope's wall time to one Timer slot.
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Timer t) : timer(t), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        Profiler::addTime(timer, static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Timer timer;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define TTT_PROFILE_CONCAT_(a, b) a##b
+#define TTT_PROFILE_CONCAT(a, b) TTT_PROFILE_CONCAT_(a, b)
+
+#ifdef TICTACTOE_PROFILE
+#define TTT_COUNT(counter) Profiler::add(counter)
+#define TTT_COUNT_N(counter, n) Profiler::add(counter, static_cast<std::uint64_t>(n))
+#define TTT_SCOPED_TIMER(timer) ScopedTimer TTT_PROFILE_CONCAT(tttScopedTimer_, __LINE__)(timer)
+#else
+#define TTT_COUNT(counter) ((void)0)
+#define TTT_COUNT_N(counter, n) ((void)0)
+#define TTT_SCOPED_TIMER(timer) ((void)0)
+#endif
@@ -0,0 +1,296 @@
+#include "Qubic.h"    // Qubic search and game declarations
+#include "AllocProfile.h" // Per-move allocation count for --alloc-profile
+#include "Bits.h"     // popcount64 / lowestBit64
+#include "Latency.h"  // Per-move latency series "qubic/alphabeta"
+#include "MoveCache.h" // Replies remembered across rounds
+#include "Profiler.h" // Search node counter
+#include "StartupProfile.h" // First-move probe for --startup-profile
+#include "ValueNet.h" // Optional learned leaf evaluator
+#include <algorithm>  // std::max
+#include <cctype>     // std::toupper for row labels
+#include <iostream>
+
+using std::cout;
+
+// ──────────────────────────────────────────────────────────────
+// QubicSearch
+int QubicSearch::evaluate(const QubicBoard& board) {
+    static constexpr int kWeight[4] = {0, 1, 8, 64}; // Open lines holding 0..3 of one side's marks
+    const std::uint64_t x = board.marks('X');
+    const std::uint64_t o = board.marks('O');
+    int score = 0;
+    for (std::uint64_t line : QubicLines::kLineMasks) {
+        int xs = popcount64(x & line);
+        int os = popcount64(o & line);
+        if (os == 0) score += kWeight[xs];
+        if (xs == 0) score -= kWeight[os];
+    }
+    return board.sideToMove() == 'X' ? score : -score;
+}
+
+int QubicSearch::leafValue(const QubicBoard& board) const {
+    if (net) return static_cast<int>(net->evaluate(board) * kNetScale);
+    return evaluate(board);
+}
+
+int QubicSearch::frontier(const QubicBoard& board, int ply) {
+    std::array<std::uint8_t, 64> moves;
+    std::array<QubicBoard, 64> leaves;
+    std::array<float, 64> values;
+    int n = orderedMoves(board, moves);
+    int pending = 0;
+    int best = -kWin - 1;
+    for (int i = 0; i < n; ++i) {
+        QubicBoard child = board;
+        child.play(moves[static_cast<size_t>(i)]);
+        ++nodes;
+        if (child.state() == GameState::TIE) best = std::max(best, 0);
+        else if (child.state() != GameState::RUNNING) return kWin - (ply + 1); // This move wins outright
+        else leaves[static_cast<size_t>(pending++)] = child;
+    }
+    net->evaluateBatch(leaves.data(), pending, values.data());
+    for (int i = 0; i < pending; ++i)
+        best = std::max(best, -static_cast<int>(values[static_cast<size_t>(i)] * kNetScale));
+    return best;
+}
+
+int QubicSearch::orderedMoves(const QubicBoard& board, std::array<std::uint8_t, 64>& out) const {
+    const char me = board.sideToMove();
+    const char opp = (me == 'X') ? 'O' : 'X';
+    if (std::uint64_t wins = board.winningCells(me)) { // Winning now dominates everything else
+        out[0] = static_cast<std::uint8_t>(lowestBit64(wins));
+        return 1;
+    }
+    int n = 0;
+    if (std::uint64_t blocks = board.winningCells(opp)) { // Must block (two threats means we lose anyway)
+        for (; blocks; blocks &= blocks - 1) out[n++] = static_cast<std::uint8_t>(lowestBit64(blocks));
+        return n;
+    }
+    const std::uint64_t occupied = board.occupied();
+    for (std::uint8_t cell : QubicLines::kCellOrder) // Cells on more lines first
+        if (!((occupied >> cell) & 1)) out[n++] = cell;
+    return n;
+}
+
+int QubicSearch::negamax(const QubicBoard& board, int depth, int alpha, int beta, int ply) {
+    ++nodes;
+    if (timed && (nodes & 4095) == 0 && std::chrono::steady_clock::now() >= deadline) aborted = true;
+    if (aborted) return 0;
+
+    if (board.state() == GameState::TIE) return 0;
+    if (board.state() != GameState::RUNNING) return -(kWin - ply); // The previous mover completed a line
+    if (depth == 0) return leafValue(board);
+    if (depth == 1 && net) return frontier(board, ply); // Batch the whole frontier through the network
+
+    std::array<std::uint8_t, 64> moves;
+    int n = orderedMoves(board, moves);
+    int best = -kWin - 1;
+    for (int i = 0; i < n; ++i) {
+        QubicBoard child = board;
+        child.play(moves[static_cast<size_t>(i)]);
+        int value = -negamax(child, depth - 1, -beta, -alpha, ply + 1);
+        if (aborted) return 0;
+        if (value > best) best = value;
+        if (value > alpha) alpha = value;
+        if (alpha >= beta) break;
+    }
+    return best;
+}
+
+int QubicSearch::rootSearch(const QubicBoard& board, int depth, int preferred, int& bestMove) {
+    std::array<std::uint8_t, 64> moves;
+    int n = orderedMoves(board, moves);
+    int kept = 0;
+    for (int i = 0; i < n; ++i) // Drop moves the threat pre-pass proved losing
+        if ((rootAllowed >> moves[static_cast<size_t>(i)]) & 1) moves[static_cast<size_t>(kept++)] = moves[static_cast<size_t>(i)];
+    if (kept > 0) n = kept; // Nothing left means every move loses: search them all anyway
+    for (int i = 1; i < n; ++i) // Previous iteration's best move is searched first
+        if (moves[static_cast<size_t>(i)] == preferred) std::swap(moves[0], moves[static_cast<size_t>(i)]);
+
+    int alpha = -kWin - 1;
+    bestMove = n ? moves[0] : -1;
+    for (int i = 0; i < n; ++i) {
+        QubicBoard child = board;
+        child.play(moves[static_cast<size_t>(i)]);
+        int value = -negamax(child, depth - 1, -kWin - 1, -alpha, 1);
+        if (aborted) return 0;
+        if (value > alpha) {
+            alpha = value;
+            bestMove = moves[static_cast<size_t>(i)];
+        }
+    }
+    return alpha;
+}
+
+int QubicSearch::chooseMove(const QubicBoard& board) {
+    static const int latencySeries = LatencyRecorder::series("qubic/alphabeta");
+    LatencyTimer latency(latencySeries);
+
+    nodes = 0;
+    completedDepth = 0;
+    rootScore = 0;
+    timed = true;
+    aborted = false;
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(budgetMs);
+    rootAllowed = ~0ULL;
+
+    if (useThreats) { // Threat-space pre-pass: forced wins and forced defences
+        int forced = -1;
+        if (threats.findWin(board, forced)) {
+            rootScore = kWin;
+            return forced;
+        }
+        rootAllowed = threats.defendingMoves(board);
+        if (popcount64(rootAllowed) == 1) return lowestBit64(rootAllowed); // Only one move survives
+        if (rootAllowed == 0) rootAllowed = ~0ULL; // Lost against best play; let alpha-beta pick the longest defence
+    }
+
+    int best = -1;
+    const int empties = 64 - popcount64(board.occupied());
+    for (int depth = 1; depth <= empties; ++depth) { // Iterative deepening until the budget runs out
+        int move = -1;
+        int value = rootSearch(board, depth, best, move);
+        if (aborted) break;
+        best = move;
+        completedDepth = depth;
+        rootScore = value;
+        if (value >= kWin - 64 || value <= -(kWin - 64)) break; // Proven result; deeper search cannot change it
+    }
+    if (best < 0) { // Not even depth 1 finished: fall back to the first ordered move
+        std::array<std::uint8_t, 64> moves;
+        if (orderedMoves(board, moves) > 0) best = moves[0];
+    }
+    TTT_COUNT_N(Counter::SearchNodes, nodes);
+    return best;
+}
+
+int QubicSearch::searchFixedDepth(const QubicBoard& board, int depth) {
+    nodes = 0;
+    timed = false;
+    aborted = false;
+    rootAllowed = ~0ULL;
+    int move = -1;
+    rootSearch(board, depth, -1, move);
+    completedDepth = depth;
+    TTT_COUNT_N(Counter::SearchNodes, nodes);
+    return move;
+}
+
+// ──────────────────────────────────────────────────────────────
+// Qubic (interactive wrapper)
+int Qubic::cellFromLabels(int layer, char rowLabel, int colLabel) {
+    int row = std::toupper(static_cast<unsigned char>(rowLabel)) - 'A';
+    if (layer < 1 || layer > 4 || row < 0 || row > 3 || colLabel < 1 || colLabel > 4) return -1;
+    return (layer - 1) * 16 + row * 4 + (colLabel - 1);
+}
+
+Qubic::Qubic(QubicAgent agentKind, int budgetMs)
+    : agent(agentKind), alphaBeta(budgetMs), mcts(budgetMs) {}
+
+void Qubic::setValueNet(const ValueNet* net) {
+    netLeaves = net != nullptr;
+    alphaBeta.setValueNet(net);
+    if (net) mcts.setEvaluator([net](const QubicBoard* boards, int count, float* out) { net->evaluateBatch(boards, count, out); });
+    else mcts.setEvaluator(nullptr);
+}
+
+void Qubic::resetGame() {
+    board.reset();
+}
+
+void Qubic::resetSession() {
+    resetGame();
+    scoreHuman = 0;
+    scoreCPU = 0;
+}
+
+void Qubic::setAgent(QubicAgent kind, int budgetMs) {
+    agent = kind;
+    alphaBeta.setBudget(budgetMs);
+    mcts.setBudget(budgetMs);
+}
+
+void Qubic::drawBoard() const {
+    drawBoard(cout);
+}
+
+void Qubic::drawBoard(std::ostream& out) const {
+    TTT_SCOPED_TIMER(Timer::Render);
+    out << "\n";
+    for (int l = 0; l < 4; ++l) out << "   Layer " << (l + 1) << "      ";
+    out << "\n";
+    for (int l = 0; l < 4; ++l) out << "    1 2 3 4     ";
+    out << "\n";
+    for (int r = 0; r < 4; ++r) {
+        for (int l = 0; l < 4; ++l) {
+            out << "  " << static_cast<char>('A' + r) << " ";
+            for (int c = 0; c < 4; ++c) {
+                char mark = board.cellAt(l * 16 + r * 4 + c);
+                out << (mark == ' ' ? '.' : mark) << ' ';
+            }
+            out << "    ";
+        }
+        out << "\n";
+    }
+    out << "\n";
+}
+
+void Qubic::playerMove(int cell) {
+    if (board.state() != GameState::RUNNING) return;
+    if (!board.play(cell)) {
+        cout << "Invalid move. Use layer 1-4, row A-D and column 1-4, and choose an empty cell.\n";
+        return;
+    }
+    TTT_COUNT(Counter::Moves);
+}
+
+void Qubic::computerMove() {
+    computerMove(cout);
+}
+
+void Qubic::computerMove(std::ostream& out) {
+    if (board.state() != GameState::RUNNING) return;
+    StartupProbe startup;
+    MoveAllocProbe allocations(AllocTag::Search);
+    TTT_SCOPED_TIMER(Timer::ComputerMove);
+    const auto tag = static_cast<std::uint8_t>(static_cast<int>(agent) * 2 + (netLeaves ? 1 : 0));
+    CachedMove cached;
+    int cell;
+    if (cache && cache->lookup(board, tag, cached) && board.isLegal(cached.move)) {
+        cell = cached.move;
+    } else {
+        cell = (agent == QubicAgent::MCTS) ? mcts.chooseMove(board) : alphaBeta.chooseMove(board);
+        if (cache && cell >= 0) {
+            cached.move = cell;
+            cached.value = agent == QubicAgent::MCTS ? 0 : alphaBeta.lastScore();
+            cached.proven = agent == QubicAgent::ALPHA_BETA && alphaBeta.lastProven();
+            cache->store(board, tag, cached);
+        }
+    }
+    if (cell < 0) return;
+    board.play(cell);
+    TTT_COUNT(Counter::Moves);
+    out << "Computer plays layer " << (cell / 16 + 1) << ", " << static_cast<char>('A' + (cell / 4) % 4)
+        << " " << (cell % 4 + 1) << "\n";
+}
+
+void Qubic::printResult() {
+    printResult(cout);
+}
+
+void Qubic::printResult(std::ostream& out) {
+    switch (board.state()) {
+    case GameState::HUMAN_WIN: out << "Human wins!\n"; ++scoreHuman; break;
+    case GameState::CPU_WIN:   out << "Computer wins!\n"; ++scoreCPU; break;
+    case GameState::TIE:       out << "It's a tie!\n"; break;
+    default: break;
+    }
+}
+
+void Qubic::printScores() const {
+    printScores(cout);
+}
+
+void Qubic::printScores(std::ostream& out) const {
+    out << "Human Score: " << scoreHuman << " | Computer Score: " << scoreCPU << "\n";
+}
@@ -0,0 +1,94 @@
+#pragma once // Ensure the header is included only once during compilation
+#include "QubicBoard.h"   // Bitboard rules and line tables
+#include "Mcts.h"         // Generic MCTS agent
+#include "ThreatSearch.h" // Forced-win pre-pass for QubicSearch
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>         // std::ostream for the output overloads
+
+class ValueNet;  // Optional learned evaluator (ValueNet.h)
+class MoveCache; // Optional reply cache (MoveCache.h)
+
+// Iterative-deepening alpha-beta (negamax) with a line-count heuristic and
+// forced win/block pruning, bounded by a wall-clock budget per move.
+class QubicSearch {
+public:
+    explicit QubicSearch(int budget = 100) : budgetMs(budget > 0 ? budget : 1) {} // Milliseconds per move
+
+    void setThreatSearch(bool enabled) { useThreats = enabled; }   // Threat-space pre-pass (on by default)
+    void setBudget(int budget) { budgetMs = budget > 0 ? budget : 1; }
+    void setValueNet(const ValueNet* valueNet) { net = valueNet; } // Leaf evaluator instead of evaluate(); nullptr restores it
+    int chooseMove(const QubicBoard& board);                       // Best move for the side to move (-1 if none)
+    int searchFixedDepth(const QubicBoard& board, int depth);      // Unbounded-time search, for benchmarks
+    std::uint64_t lastNodes() const { return nodes; }
+    int lastDepth() const { return completedDepth; }
+    int lastScore() const { return rootScore; }                        // Value of the last completed iteration
+    bool lastProven() const { return rootScore >= kWin - 64 || rootScore <= -(kWin - 64); } // Forced win or loss
+
+    static int evaluate(const QubicBoard& board);                  // Static score for the side to move
+
+private:
+    static constexpr int kWin = 1000000;
+    static constexpr int kNetScale = 1000;                         // ValueNet output [-1, 1] -> search score
+
+    int budgetMs;
+    bool useThreats = true;
+    const ValueNet* net = nullptr;
+    ThreatSearch threats;
+    std::uint64_t rootAllowed = ~0ULL;                             // Root moves the pre-pass left open
+    std::uint64_t nodes = 0;
+    int completedDepth = 0;
+    int rootScore = 0;
+    bool timed = false;
+    bool aborted = false;
+    std::chrono::steady_clock::time_point deadline;
+
+    int rootSearch(const QubicBoard& board, int depth, int preferred, int& bestMove);
+    int negamax(const QubicBoard& board, int depth, int alpha, int beta, int ply);
+    int leafValue(const QubicBoard& board) const;                  // evaluate() or the network
+    int frontier(const QubicBoard& board, int ply);                // Depth-1 node scored with one batched network call
+    int orderedMoves(const QubicBoard& board, std::array<std::uint8_t, 64>& out) const; // Forced replies only when threatened
+};
+
+// Which engine drives Qubic::computerMove.
+enum class QubicAgent { ALPHA_BETA, MCTS };
+
+// Qubic round/score wrapper mirroring the TicTacToe interface, so the same
+// Interface flow can drive it. Human plays X and moves first.
+class Qubic {
+public:
+    static int cellFromLabels(int layer, char rowLabel, int colLabel); // (1..4, 'A'..'D', 1..4) -> 0..63, or -1
+
+    explicit Qubic(QubicAgent agent = QubicAgent::ALPHA_BETA, int budgetMs = 500);
+
+    void resetGame();
+    void resetSession();                        // Also zero the scores (a recycled game's new player)
+    void setAgent(QubicAgent kind, int budgetMs); // Engine and per-move budget, as passed to the constructor
+    void drawBoard() const;                     // Four layers side by side
+    void drawBoard(std::ostream& out) const;
+    bool isAvailable(int cell) const { return board.isLegal(cell); }
+    std::uint64_t occupied() const { return board.occupied(); } // Taken cells, as TicTacToe::occupied
+    void playerMove(int cell);
+    void computerMove();
+    void computerMove(std::ostream& out);       // Announces the reply on out (async sessions)
+    void printResult();                         // Prints the outcome and updates the scores
+    void printResult(std::ostream& out);
+    void printScores() const;
+    void printScores(std::ostream& out) const;
+    GameState getState() const { return board.state(); }
+    const QubicBoard& position() const { return board; }
+    void setValueNet(const ValueNet* net);      // Both agents evaluate leaves with net (nullptr: heuristics/playouts)
+    void setMoveCache(MoveCache* moveCache) { cache = moveCache; } // Consulted before every search (nullptr: always search)
+    void seed(std::uint64_t value) { mcts.seed(value); } // MCTS playouts; alpha-beta has no randomness
+
+private:
+    QubicBoard board;
+    QubicAgent agent;
+    QubicSearch alphaBeta;
+    Mcts<QubicBoard> mcts;
+    MoveCache* cache = nullptr;
+    bool netLeaves = false;                     // Cache entries are kept apart per agent and evaluator
+    int scoreHuman = 0;
+    int scoreCPU = 0;
+};
@@ -0,0 +1,56 @@
+#include "QubicBoard.h" // Qubic board and line table declarations
+#include "Bits.h"       // popcount64 / lowestBit64
+
+// ──────────────────────────────────────────────────────────────
+// QubicBoard
+bool QubicBoard::isLegal(int cell) const {
+    return status == GameState::RUNNING && cell >= 0 && cell < kCells && !((occupied() >> cell) & 1);
+}
+
+int QubicBoard::legalMoves(std::array<std::uint8_t, kCells>& out) const {
+    if (status != GameState::RUNNING) return 0;
+    int n = 0;
+    for (std::uint64_t empty = ~occupied(); empty; empty &= empty - 1)
+        out[n++] = static_cast<std::uint8_t>(lowestBit64(empty));
+    return n;
+}
+
+bool QubicBoard::play(int cell) {
+    if (!isLegal(cell)) return false;
+    std::uint64_t& mine = (side == 'X') ? xMask : oMask;
+    mine |= 1ULL << cell;
+
+    status = Rules<CubeGeometry>::afterMove(side, mine, occupied(), cell); // Only the 4-7 lines through this cell can have completed
+    side = (side == 'X') ? 'O' : 'X';
+    return true;
+}
+
+char QubicBoard::cellAt(int cell) const {
+    if ((xMask >> cell) & 1) return 'X';
+    if ((oMask >> cell) & 1) return 'O';
+    return ' ';
+}
+
+std::uint64_t QubicBoard::winningCells(char who) const {
+    const std::uint64_t mine = marks(who);
+    const std::uint64_t theirs = marks(who == 'X' ? 'O' : 'X');
+    std::uint64_t cells = 0;
+    for (std::uint64_t line : QubicLines::kLineMasks)
+        if (!(theirs & line) && popcount64(mine & line) == 3) cells |= line & ~mine;
+    return cells;
+}
+
+std::uint64_t QubicBoard::threatCells(char who) const {
+    const std::uint64_t mine = marks(who);
+    const std::uint64_t theirs = marks(who == 'X' ? 'O' : 'X');
+    std::uint64_t cells = 0;
+    for (std::uint64_t line : QubicLines::kLineMasks)
+        if (!(theirs & line) && popcount64(mine & line) == 2) cells |= line & ~mine;
+    return cells;
+}
+
+QubicBoard QubicBoard::withSideToMove(char who) const {
+    QubicBoard copy = *this;
+    copy.side = who;
+    return copy;
+}
@@ -0,0 +1,41 @@
+#pragma once // Ensure the header is included only once during compilation
+#include "Driver.h" // GameState
+#include "Rules.h"  // CubeGeometry line tables, Rules<CubeGeometry>::afterMove
+#include <array>
+#include <cstdint>
+
+// Qubic: 4x4x4 tic-tac-toe, four in a row along any of the cube's 76 lines.
+//
+// Cell index = layer*16 + row*4 + col (all 0-based), so each player's marks fit
+// in one 64-bit mask. The line tables are CubeGeometry's constexpr tables (see
+// Rules.h): the 76 line masks and, for every cell, the 4 or 7 lines passing
+// through it, so the win check after a move only looks at those lines.
+using QubicLines = CubeGeometry;
+
+// Rules-only board used by the agents (cheap to copy: two masks and a status).
+class QubicBoard {
+public:
+    static constexpr int kCells = 64;
+    static constexpr const char* kName = "qubic";
+
+    void reset() { *this = QubicBoard{}; }
+    int legalMoves(std::array<std::uint8_t, kCells>& out) const;  // Fills out, returns count
+    bool isLegal(int cell) const;
+    bool play(int cell);                                           // Applies a legal move; false (no change) otherwise
+
+    GameState state() const { return status; }                     // HUMAN_WIN = X, CPU_WIN = O
+    char sideToMove() const { return side; }
+    std::uint64_t marks(char who) const { return who == 'X' ? xMask : oMask; }
+    std::uint64_t occupied() const { return xMask | oMask; }
+    char cellAt(int cell) const;
+
+    std::uint64_t winningCells(char who) const;                    // Empty cells that would complete a line for who
+    std::uint64_t threatCells(char who) const;                     // Empty cells that would leave who one short of a line
+    QubicBoard withSideToMove(char who) const;                     // Same marks, given side to move (null move)
+
+private:
+    std::uint64_t xMask = 0;
+    std::uint64_t oMask = 0;
+    char side = 'X';
+    GameState status = GameState::RUNNING;
+};
@@ -0,0 +1,13 @@
+#include "Rules.h" // Compile-time rules kernel
+
+GameState evaluatePosition(BoardGeometry geometry, std::uint64_t x, std::uint64_t o) {
+    switch (geometry) { // Each case runs its own fully specialized instantiation
+    case BoardGeometry::CLASSIC_3X3:
+        return Rules<ClassicGeometry>::evaluate(static_cast<ClassicGeometry::Mask>(x), static_cast<ClassicGeometry::Mask>(o));
+    case BoardGeometry::SQUARE_4X4:
+        return Rules<SquareGeometry>::evaluate(static_cast<SquareGeometry::Mask>(x), static_cast<SquareGeometry::Mask>(o));
+    case BoardGeometry::CUBE_4X4X4:
+        return Rules<CubeGeometry>::evaluate(x, o);
+    }
+    return GameState::RUNNING;
+}
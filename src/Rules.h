@@ -0,0 +1,178 @@
+#pragma once // Ensure the header is included only once during compilation
+#include "Driver.h" // GameState
+#include <array>
+#include <cstdint>
+#include <type_traits> // std::conditional_t for the mask type
+#include <utility>     // std::index_sequence for the unrolled line checks
+
+// Compile-time rules kernel.
+//
+// Geometry<N, K, Dims> describes an N x N (Dims = 2) or N x N x N (Dims = 3)
+// board won by K in a row. Its line masks, the lines through every cell and a
+// cell ordering are constexpr tables computed by the compiler, and Rules<G>
+// checks them with fold expressions, so each instantiation compiles to
+// straight-line mask tests without loops over tables or branches on the
+// player. Cells are numbered (layer*N + row)*N + col, which matches
+// TicTacToe (row*3 + col) and QubicBoard (layer*16 + row*4 + col).
+template <int N, int K, int Dims>
+struct Geometry {
+    static_assert(Dims == 2 || Dims == 3, "boards are squares or cubes");
+    static_assert(K >= 2 && K <= N, "line length must fit on the board");
+
+    static constexpr int kSide = N;
+    static constexpr int kInRow = K;
+    static constexpr int kLayers = Dims == 3 ? N : 1;
+    static constexpr int kCells = kLayers * N * N;
+    static_assert(kCells <= 64, "one mask per player must fit in 64 bits");
+
+    using Mask = std::conditional_t<(kCells <= 16), std::uint16_t,
+                 std::conditional_t<(kCells <= 32), std::uint32_t, std::uint64_t>>;
+
+    static constexpr Mask kFull = kCells == 64 ? static_cast<Mask>(~0ULL)
+                                               : static_cast<Mask>((1ULL << kCells) - 1);
+
+    // Walks every line once (one direction of each opposite pair); stores masks when out != nullptr.
+    static constexpr int generate(Mask* out) {
+        int count = 0;
+        const int dzMin = Dims == 3 ? -1 : 0;
+        const int dzMax = Dims == 3 ? 1 : 0;
+        for (int dz = dzMin; dz <= dzMax; ++dz)
+            for (int dr = -1; dr <= 1; ++dr)
+                for (int dc = -1; dc <= 1; ++dc) {
+                    const int first = dz != 0 ? dz : (dr != 0 ? dr : dc);
+                    if (first <= 0) continue;
+                    for (int z = 0; z < kLayers; ++z)
+                        for (int r = 0; r < N; ++r)
+                            for (int c = 0; c < N; ++c) {
+                                const int ez = z + (K - 1) * dz, er = r + (K - 1) * dr, ec = c + (K - 1) * dc;
+                                if (ez < 0 || ez >= kLayers || er < 0 || er >= N || ec < 0 || ec >= N) continue;
+                                if (out) {
+                                    std::uint64_t m = 0;
+                                    for (int k = 0; k < K; ++k)
+                                        m |= 1ULL << (((z + k * dz) * N + (r + k * dr)) * N + (c + k * dc));
+                                    out[count] = static_cast<Mask>(m);
+                                }
+                                ++count;
+                            }
+                }
+        return count;
+    }
+
+    static constexpr int kLines = generate(nullptr);
+
+    static constexpr std::array<Mask, kLines> buildLines() {
+        std::array<Mask, kLines> lines{};
+        generate(lines.data());
+        return lines;
+    }
+    static constexpr std::array<Mask, kLines> kLineMasks = buildLines();
+
+    static constexpr std::array<std::uint8_t, kCells> buildThroughCount() {
+        std::array<std::uint8_t, kCells> count{};
+        for (int l = 0; l < kLines; ++l)
+            for (int cell = 0; cell < kCells; ++cell)
+                if ((kLineMasks[l] >> cell) & 1) ++count[cell];
+        return count;
+    }
+    static constexpr std::array<std::uint8_t, kCells> kThroughCount = buildThroughCount();
+
+    static constexpr int maxThrough() {
+        int m = 0;
+        for (int cell = 0; cell < kCells; ++cell)
+            if (kThroughCount[cell] > m) m = kThroughCount[cell];
+        return m;
+    }
+    static constexpr int kMaxThrough = maxThrough();
+
+    using ThroughTable = std::array<std::array<std::uint8_t, kMaxThrough>, kCells>;
+    static constexpr ThroughTable buildThrough() {
+        ThroughTable through{};
+        std::array<std::uint8_t, kCells> fill{};
+        for (int l = 0; l < kLines; ++l)
+            for (int cell = 0; cell < kCells; ++cell)
+                if ((kLineMasks[l] >> cell) & 1) through[cell][fill[cell]++] = static_cast<std::uint8_t>(l);
+        return through;
+    }
+    static constexpr ThroughTable kThrough = buildThrough(); // Line indices through each cell
+
+    static constexpr std::array<std::uint8_t, kCells> buildCellOrder() { // Most lines first, stable
+        std::array<std::uint8_t, kCells> order{};
+        for (int i = 0; i < kCells; ++i) order[i] = static_cast<std::uint8_t>(i);
+        for (int i = 1; i < kCells; ++i)
+            for (int j = i; j > 0 && kThroughCount[order[j]] > kThroughCount[order[j - 1]]; --j) {
+                std::uint8_t t = order[j];
+                order[j] = order[j - 1];
+                order[j - 1] = t;
+            }
+        return order;
+    }
+    static constexpr std::array<std::uint8_t, kCells> kCellOrder = buildCellOrder();
+};
+
+using ClassicGeometry = Geometry<3, 3, 2>; // TicTacToe, Ultimate sub-boards and macro board
+using SquareGeometry = Geometry<4, 4, 2>;  // 4x4, four in a row
+using CubeGeometry = Geometry<4, 4, 3>;    // Qubic
+
+static_assert(ClassicGeometry::kLines == 8, "3x3 has 8 lines");
+static_assert(SquareGeometry::kLines == 10, "4x4 has 10 lines");
+static_assert(CubeGeometry::kLines == 76, "4x4x4 has 76 lines");
+
+// Rules for one geometry; the player is a template argument wherever it matters.
+template <class G>
+struct Rules {
+    using Mask = typename G::Mask;
+
+    template <char Side>
+    static constexpr GameState kWinState = Side == 'X' ? GameState::HUMAN_WIN : GameState::CPU_WIN;
+
+    // Any complete line in mine? Unrolled over every line, no early exit.
+    static constexpr bool hasLine(Mask mine) { return anyLine(mine, std::make_index_sequence<G::kLines>{}); }
+
+    // Any complete line through cell? Only the lines touching that cell are tested.
+    static constexpr bool completesLine(Mask mine, int cell) {
+        bool hit = false;
+        for (int i = 0; i < G::kThroughCount[cell]; ++i) {
+            const Mask line = G::kLineMasks[G::kThrough[cell][i]];
+            hit |= (mine & line) == line;
+        }
+        return hit;
+    }
+
+    // State after Side placed a mark on cell: Side's win, a full-board tie or still running.
+    template <char Side>
+    static constexpr GameState afterMove(Mask mine, Mask occupied, int cell) {
+        static_assert(Side == 'X' || Side == 'O', "players are X and O");
+        if (completesLine(mine, cell)) return kWinState<Side>;
+        return occupied == G::kFull ? GameState::TIE : GameState::RUNNING;
+    }
+
+    static constexpr GameState afterMove(char side, Mask mine, Mask occupied, int cell) { // Runtime dispatcher
+        return side == 'X' ? afterMove<'X'>(mine, occupied, cell) : afterMove<'O'>(mine, occupied, cell);
+    }
+
+    // Full evaluation: X line, else O line, else tie if full, else running — computed without branches.
+    static constexpr GameState evaluate(Mask x, Mask o) {
+        const int xWins = hasLine(x);
+        const int oWins = hasLine(o) & !xWins;
+        const int full = ((x | o) == G::kFull) & !xWins & !oWins;
+        return static_cast<GameState>(xWins * static_cast<int>(GameState::HUMAN_WIN) +
+                                      oWins * static_cast<int>(GameState::CPU_WIN) +
+                                      full * static_cast<int>(GameState::TIE));
+    }
+
+private:
+    template <std::size_t... I>
+    static constexpr bool anyLine(Mask m, std::index_sequence<I...>) {
+        return (false | ... | ((m & G::kLineMasks[I]) == G::kLineMasks[I]));
+    }
+};
+
+static_assert(static_cast<int>(GameState::RUNNING) == 0, "Rules::evaluate builds states arithmetically");
+static_assert(Rules<ClassicGeometry>::evaluate(0007, 0070) == GameState::HUMAN_WIN, "row A for X");
+static_assert(Rules<ClassicGeometry>::evaluate(0, 0124) == GameState::CPU_WIN, "anti-diagonal for O");
+static_assert(Rules<ClassicGeometry>::evaluate(0, 0) == GameState::RUNNING, "empty board");
+
+// Runtime dispatch over the geometries the engine ships.
+enum class BoardGeometry { CLASSIC_3X3, SQUARE_4X4, CUBE_4X4X4 };
+
+GameState evaluatePosition(BoardGeometry geometry, std::uint64_t x, std::uint64_t o);
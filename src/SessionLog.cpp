@@ -0,0 +1,99 @@
+#include "SessionLog.h" // Session log declarations
+#include <cstdio>       // std::snprintf for the header line
+#include <cstdlib>      // std::strtoull / std::strtod
+#include <sstream>      // Header fields
+
+namespace {
+const char* variantName(Variant v) {
+    return v == Variant::QUBIC ? "qubic" : v == Variant::ULTIMATE ? "ultimate" : "classic";
+}
+const char* difficultyName(Difficulty d) {
+    return d == Difficulty::PERFECT ? "perfect" : d == Difficulty::ADAPTIVE ? "adaptive" : "random";
+}
+const char* agentName(QubicAgent a) { return a == QubicAgent::MCTS ? "mcts" : "alphabeta"; }
+
+// Applies one "key=value" header field; false if the key or value is unknown
+bool applyField(const std::string& key, const std::string& value, SessionHeader& h) {
+    if (key == "seed") h.seed = std::strtoull(value.c_str(), nullptr, 16);
+    else if (key == "target") h.targetRate = std::strtod(value.c_str(), nullptr);
+    else if (key == "move-ms") h.moveMs = static_cast<int>(std::strtol(value.c_str(), nullptr, 10));
+    else if (key == "variant") {
+        if (value == "classic") h.variant = Variant::CLASSIC;
+        else if (value == "qubic") h.variant = Variant::QUBIC;
+        else return false;
+    } else if (key == "difficulty") {
+        if (value == "random") h.difficulty = Difficulty::RANDOM;
+        else if (value == "adaptive") h.difficulty = Difficulty::ADAPTIVE;
+        else if (value == "perfect") h.difficulty = Difficulty::PERFECT;
+        else return false;
+    } else if (key == "agent") {
+        if (value == "alphabeta") h.agent = QubicAgent::ALPHA_BETA;
+        else if (value == "mcts") h.agent = QubicAgent::MCTS;
+        else return false;
+    } else return false;
+    return true;
+}
+} // namespace
+
+bool SessionLog::record(const std::string& path, const SessionHeader& header, std::string& error) {
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) { error = path + ": cannot create"; return false; }
+    settings = header;
+    char seed[17];
+    std::snprintf(seed, sizeof seed, "%016llx", static_cast<unsigned long long>(header.seed));
+    out << "TTTR 1 seed=" << seed << " variant=" << variantName(header.variant)
+        << " difficulty=" << difficultyName(header.difficulty) << " target=" << header.targetRate
+        << " agent=" << agentName(header.agent) << " move-ms=" << header.moveMs << "\n" << std::flush;
+    return true;
+}
+
+bool SessionLog::load(const std::string& path, std::string& error) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) { error = path + ": cannot open"; return false; }
+    std::string line;
+    if (!std::getline(in, line) || line.rfind("TTTR 1 ", 0) != 0) { error = path + ": not a session recording"; return false; }
+    std::istringstream fields(line.substr(7));
+    for (std::string field; fields >> field;) {
+        const std::size_t eq = field.find('=');
+        if (eq == std::string::npos || !applyField(field.substr(0, eq), field.substr(eq + 1), settings)) {
+            error = path + ": bad header field '" + field + "'";
+            return false;
+        }
+    }
+    for (std::size_t n = 2; std::getline(in, line); ++n) {
+        if (!line.empty() && line[0] == '>') lines.push_back(line.substr(1));
+        else if (!line.empty() && line[0] == '<') cells.push_back(std::atoi(line.c_str() + 1));
+        else { error = path + ": line " + std::to_string(n) + " is neither input nor reply"; return false; }
+    }
+    return true;
+}
+
+void SessionLog::input(std::string_view line) {
+    ++inputCount;
+    out << '>' << line << '\n' << std::flush;
+}
+
+std::optional<std::string_view> SessionLog::nextInput() {
+    if (inputCount == lines.size()) return std::nullopt;
+    return std::string_view(lines[inputCount++]);
+}
+
+void SessionLog::finish() {
+    if (!replaying() || replyCount >= cells.size()) return;
+    if (mismatches++ == 0)
+        firstMismatch = "session ended after " + std::to_string(replyCount) + " of " + std::to_string(cells.size()) + " CPU replies";
+}
+
+void SessionLog::reply(int cell) {
+    const std::size_t n = replyCount++;
+    if (!replaying()) {
+        out << '<' << cell << '\n' << std::flush;
+        return;
+    }
+    const int expected = n < cells.size() ? cells[n] : -1;
+    if (cell == expected) return;
+    if (mismatches++ == 0)
+        firstMismatch = "CPU reply " + std::to_string(n + 1) + " (after input line " + std::to_string(inputCount) +
+                        "): recorded " + (expected < 0 ? std::string("none") : std::to_string(expected)) + ", replayed " +
+                        std::to_string(cell);
+}
@@ -0,0 +1,63 @@
+#pragma once // Ensure the header is included only once during compilation
+#include "Driver.h"  // Variant, Difficulty
+#include "Qubic.h"   // QubicAgent
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Settings a session needs to play out the same way again.
+struct SessionHeader {
+    std::uint64_t seed = 0;       // Fed to TicTacToe::seed / Qubic::seed before the first round
+    Variant variant = Variant::CLASSIC;
+    Difficulty difficulty = Difficulty::RANDOM;
+    double targetRate = 0.4;
+    QubicAgent agent = QubicAgent::ALPHA_BETA;
+    int moveMs = 500;
+};
+
+// Record and replay of console sessions (--record / --replay).
+//
+// A recording holds the RNG seed and the settings, then every raw input
+// line, plus the CPU's reply after each human move. Each record is one text
+// line:
+//   TTTR 1 seed=<hex> variant=<v> difficulty=<d> target=<r> agent=<a> move-ms=<ms>
+//   ><input line exactly as read>
+//   <<cell>
+// Lines are flushed as they are written, so the log survives a crash.
+//
+// A replay feeds the recorded lines back in place of stdin and checks
+// every CPU reply against the recording. The first mismatch is the point
+// where behaviour changed. Classic games replay exactly. Qubic searches
+// stop on a clock, so a reply can differ when the machine is slower or
+// faster.
+class SessionLog {
+public:
+    bool record(const std::string& path, const SessionHeader& header, std::string& error);
+    bool load(const std::string& path, std::string& error); // Replay mode
+    bool replaying() const { return !out.is_open(); }
+    const SessionHeader& header() const { return settings; }
+
+    void input(std::string_view line);          // Recording: one line read from stdin
+    std::optional<std::string_view> nextInput(); // Replay: next recorded line; nullopt at the end
+    void reply(int cell);                       // Records the CPU's cell, or checks it when replaying
+    void finish();                              // Replay: recorded replies that never came count as a divergence
+
+    std::size_t inputs() const { return inputCount; }
+    std::size_t replies() const { return replyCount; }
+    std::size_t divergences() const { return mismatches; }
+    std::string firstDivergence() const { return firstMismatch; } // Empty when the replay matched
+
+private:
+    SessionHeader settings;
+    std::ofstream out;                 // Open while recording
+    std::vector<std::string> lines;    // Replay: recorded input
+    std::vector<int> cells;            // Replay: recorded CPU replies
+    std::size_t inputCount = 0;        // Lines written or handed back so far
+    std::size_t replyCount = 0;
+    std::size_t mismatches = 0;
+    std::string firstMismatch;
+};
@@ -0,0 +1,128 @@
+#include "Simulation.h" // Self-play declarations
+#include "BatchEngine.h" // Lockstep structure-of-arrays 3x3 games
+#include "Driver.h"     // TicTacToe rules and computerMove
+#include "Ultimate.h"   // Ultimate board and MCTS agent
+#include "ValueNet.h"   // Learned evaluator for Qubic self-play
+#include <algorithm>    // std::max
+#include <chrono>       // Batch wall time
+#include <iomanip>
+#include <ostream>
+#include <thread>       // Worker threads
+#include <vector>
+
+namespace {
+// Runs `games` games split across `threads` workers. makePlayer(id) returns a
+// callable that plays one complete game and returns its final GameState.
+template <class MakePlayer>
+SimulationStats runBatch(long long games, int threads, MakePlayer makePlayer) {
+    if (threads <= 0) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    if (games < threads) threads = static_cast<int>(std::max(1LL, games));
+
+    std::vector<SimulationStats> partial(static_cast<size_t>(threads)); // One slot per worker; merged after join
+    auto worker = [&](int id) {
+        long long share = games / threads + (id < games % threads ? 1 : 0);
+        SimulationStats& s = partial[static_cast<size_t>(id)];
+        auto playOne = makePlayer(id);
+        for (long long g = 0; g < share; ++g) {
+            switch (playOne()) {
+            case GameState::HUMAN_WIN: ++s.xWins; break;
+            case GameState::CPU_WIN:   ++s.oWins; break;
+            default:                   ++s.ties;  break;
+            }
+            ++s.games;
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0); // The calling thread takes share 0
+    for (auto& th : pool) th.join();
+
+    SimulationStats total;
+    for (const auto& s : partial) {
+        total.games += s.games;
+        total.xWins += s.xWins;
+        total.oWins += s.oWins;
+        total.ties += s.ties;
+    }
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return total;
+}
+} // namespace
+
+SimulationStats Simulation::selfPlay(long long games, int threads, Difficulty difficulty) {
+    return runBatch(games, threads, [difficulty](int) {
+        TicTacToe game;
+        game.setDifficulty(difficulty);
+        return [game]() mutable {
+            game.resetGame();
+            while (game.getState() == GameState::RUNNING) game.computerMove(); // Alternates X and O
+            return game.getState();
+        };
+    });
+}
+
+SimulationStats Simulation::selfPlayBatch(long long games, int threads) {
+    if (threads <= 0) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    if (games < threads) threads = static_cast<int>(std::max(1LL, games));
+    const auto seed = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+
+    std::vector<BatchStats> partial(static_cast<size_t>(threads));
+    auto worker = [&](int id) {
+        long long share = games / threads + (id < games % threads ? 1 : 0);
+        BatchEngine engine(4096, seed + static_cast<std::uint64_t>(id) * 4096); // Lane seeds never overlap between workers
+        partial[static_cast<size_t>(id)] = engine.play(static_cast<std::uint64_t>(share));
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+
+    SimulationStats total;
+    for (const auto& s : partial) {
+        total.games += static_cast<long long>(s.games);
+        total.xWins += static_cast<long long>(s.xWins);
+        total.oWins += static_cast<long long>(s.oWins);
+        total.ties += static_cast<long long>(s.ties);
+    }
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return total;
+}
+
+SimulationStats Simulation::selfPlayUltimate(long long games, int threads, int moveMs) {
+    return runBatch(games, threads, [moveMs](int) {
+        return [agent = UltimateMcts(moveMs)]() mutable {
+            UltimateBoard board;
+            while (board.state() == GameState::RUNNING) board.play(agent.chooseMove(board));
+            return board.state();
+        };
+    });
+}
+
+SimulationStats Simulation::selfPlayQubic(long long games, int threads, QubicAgent agent, int moveMs, const ValueNet* net) {
+    return runBatch(games, threads, [agent, moveMs, net](int) {
+        QubicSearch alphaBeta(moveMs);
+        Mcts<QubicBoard> mcts(moveMs);
+        if (net) {
+            alphaBeta.setValueNet(net);
+            mcts.setEvaluator([net](const QubicBoard* boards, int count, float* out) { net->evaluateBatch(boards, count, out); });
+        }
+        return [agent, alphaBeta, mcts]() mutable {
+            QubicBoard board;
+            while (board.state() == GameState::RUNNING)
+                board.play(agent == QubicAgent::MCTS ? mcts.chooseMove(board) : alphaBeta.chooseMove(board));
+            return board.state();
+        };
+    });
+}
+
+void Simulation::printSummary(const SimulationStats& stats, std::ostream& out) {
+    double rate = stats.seconds > 0 ? static_cast<double>(stats.games) / stats.seconds : 0.0;
+    out << "Simulated " << stats.games << " games in " << std::fixed << std::setprecision(3) << stats.seconds
+        << " s (" << std::setprecision(0) << rate << " games/s)\n";
+    out.unsetf(std::ios::floatfield);
+    out << "X wins: " << stats.xWins << " | O wins: " << stats.oWins << " | Ties: " << stats.ties << "\n";
+}
@@ -0,0 +1,25 @@
+#pragma once // Ensure the header is included only once during compilation
+#include "Qubic.h" // QubicAgent
+#include <iosfwd> // std::ostream forward declaration
+
+// Outcome tally of a batch of CPU-vs-CPU games.
+struct SimulationStats {
+    long long games = 0;   // Games completed
+    long long xWins = 0;   // Games won by the first mover ('X')
+    long long oWins = 0;   // Games won by the second mover ('O')
+    long long ties = 0;    // Drawn games
+    double seconds = 0.0;  // Wall time for the whole batch
+};
+
+// Headless self-play driver: plays an agent against itself with no console
+// output, splitting the games across worker threads.
+class Simulation {
+public:
+    static SimulationStats selfPlay(long long games, int threads, // threads <= 0 means hardware concurrency
+                                    Difficulty difficulty = Difficulty::RANDOM); // Agent for both sides
+    static SimulationStats selfPlayBatch(long long games, int threads); // Random 3x3 games through BatchEngine
+    static SimulationStats selfPlayUltimate(long long games, int threads, int moveMs); // MCTS vs MCTS
+    static SimulationStats selfPlayQubic(long long games, int threads, QubicAgent agent, int moveMs,
+                                         const ValueNet* net = nullptr); // net: shared, read-only leaf evaluator
+    static void printSummary(const SimulationStats& stats, std::ostream& out);
+};
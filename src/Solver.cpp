@@ -0,0 +1,106 @@
+#include "Solver.h" // Solved-table declarations
+#include "Driver.h" // TicTacToe::hasLine / kFullMask
+#include "Bits.h"   // popcount64
+
+namespace {
+constexpr int kPow3[9] = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+
+// Negamax over every position reachable from (x, o), memoised in t. The
+// base-3 index is carried along (a child adds 3^cell or 2*3^cell) instead of
+// being re-encoded for every position.
+int solve(std::array<std::int8_t, Solver::kPositions>& t, std::uint16_t x, std::uint16_t o, int idx) {
+    if (t[idx] != Solver::kUnreachable) return t[idx];
+
+    const int marks = popcount64(static_cast<std::uint16_t>(x | o));
+    const bool xToMove = popcount64(x) == popcount64(o);
+    int value;
+    if (TicTacToe::hasLine(xToMove ? o : x)) {
+        value = -(10 - marks);                          // The previous mover just won
+    } else if ((x | o) == TicTacToe::kFullMask) {
+        value = 0;                                      // Full board, no line
+    } else {
+        value = -100;
+        for (int cell = 0; cell < 9; ++cell) {
+            const std::uint16_t bit = static_cast<std::uint16_t>(1u << cell);
+            if ((x | o) & bit) continue;
+            int child = xToMove ? solve(t, static_cast<std::uint16_t>(x | bit), o, idx + kPow3[cell])
+                                : solve(t, x, static_cast<std::uint16_t>(o | bit), idx + 2 * kPow3[cell]);
+            if (-child > value) value = -child;
+        }
+    }
+    t[idx] = static_cast<std::int8_t>(value);
+    return value;
+}
+} // namespace
+
+const std::array<std::int8_t, Solver::kPositions>& Solver::table() {
+    static const std::array<std::int8_t, kPositions> solved = [] { // Built once, thread-safe
+        std::array<std::int8_t, kPositions> t;
+        t.fill(kUnreachable);
+        solve(t, 0, 0, 0);
+        return t;
+    }();
+    return solved;
+}
+
+int Solver::index(std::uint16_t x, std::uint16_t o) {
+    int idx = 0;
+    for (int cell = 0; cell < 9; ++cell) {
+        if ((x >> cell) & 1) idx += kPow3[cell];
+        else if ((o >> cell) & 1) idx += 2 * kPow3[cell];
+    }
+    return idx;
+}
+
+bool Solver::isValid(std::uint16_t x, std::uint16_t o) {
+    if ((x | o) & ~TicTacToe::kFullMask) return false;
+    if (x & o) return false;
+    return table()[index(x, o)] != kUnreachable; // Reachable positions are exactly the legal ones
+}
+
+int Solver::value(std::uint16_t x, std::uint16_t o) {
+    if ((x | o) & ~TicTacToe::kFullMask || (x & o)) return kUnreachable;
+    return table()[index(x, o)];
+}
+
+int Solver::moveValue(std::uint16_t x, std::uint16_t o, int cell) {
+    if (cell < 0 || cell > 8 || (((x | o) >> cell) & 1)) return kUnreachable;
+    const std::uint16_t bit = static_cast<std::uint16_t>(1u << cell);
+    const bool xToMove = popcount64(x) == popcount64(o);
+    int child = xToMove ? value(static_cast<std::uint16_t>(x | bit), o) : value(x, static_cast<std::uint16_t>(o | bit));
+    return child == kUnreachable ? kUnreachable : -child;
+}
+
+int Solver::bestMove(std::uint16_t x, std::uint16_t o) {
+    std::array<int, 9> values;
+    if (analyze(x, o, values) == 0) return -1;
+    int best = -1;
+    int bestValue = -100;
+    for (int cell = 0; cell < 9; ++cell) {
+        if (values[cell] != kUnreachable && values[cell] > bestValue) {
+            bestValue = values[cell];
+            best = cell;
+        }
+    }
+    return best;
+}
+
+int Solver::analyze(std::uint16_t x, std::uint16_t o, std::array<int, 9>& values) {
+    values.fill(kUnreachable);
+    if ((x | o) & ~TicTacToe::kFullMask || (x & o)) return 0;
+    const auto& t = table();
+    const int idx = index(x, o);
+    if (t[idx] == kUnreachable || TicTacToe::hasLine(x) || TicTacToe::hasLine(o)) return 0;
+    const int step = popcount64(x) == popcount64(o) ? 1 : 2; // Digit the mover writes into the base-3 index
+    int legal = 0;
+    for (int cell = 0; cell < 9; ++cell) {
+        if (((x | o) >> cell) & 1) continue;
+        values[cell] = -t[idx + step * kPow3[cell]]; // Children share the parent's index: one add each
+        ++legal;
+    }
+    return legal;
+}
+
+int Solver::pliesToEnd(int value, int marks) {
+    return (value > 0 ? 10 - value : value < 0 ? 10 + value : 9) - marks; // Values encode the mark count at the end
+}
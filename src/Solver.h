@@ -0,0 +1,27 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <array>
+#include <cstdint>
+
+// Perfect-play table for the classic 3x3 board.
+//
+// Positions are X/O cell masks in TicTacToe's bit layout (row*3 + col). The
+// side to move follows from the counts (X moves first). Values are from the
+// side to move's point of view: +(10 - marks on the board when the game ends)
+// for a forced win, the negative of that for a forced loss, 0 for a draw, so
+// faster wins and slower losses score higher. The table covers every
+// reachable position (3^9 slots) and is built once on first use.
+class Solver {
+public:
+    static constexpr int kPositions = 19683;        // 3^9 base-3 encodings
+    static constexpr std::int8_t kUnreachable = -128;
+
+    static int index(std::uint16_t x, std::uint16_t o);          // Base-3 encoding: 0 empty, 1 X, 2 O
+    static bool isValid(std::uint16_t x, std::uint16_t o);       // Disjoint, legal counts, at most one winner
+    static int value(std::uint16_t x, std::uint16_t o);          // Value for the side to move (kUnreachable if invalid)
+    static int moveValue(std::uint16_t x, std::uint16_t o, int cell); // Value of playing cell, same perspective
+    static int bestMove(std::uint16_t x, std::uint16_t o);       // Fastest win / slowest loss; -1 if none
+    static int analyze(std::uint16_t x, std::uint16_t o, std::array<int, 9>& values); // moveValue of every cell in one pass; returns the legal count
+    static int pliesToEnd(int value, int marks);                  // Moves left in the game, counting the one valued, under perfect play
+
+    static const std::array<std::int8_t, kPositions>& table();    // Values by index (kUnreachable for illegal positions)
+};
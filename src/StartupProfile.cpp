@@ -0,0 +1,76 @@
+#include "StartupProfile.h" // Startup timeline declarations
+#include <algorithm>        // std::find_if
+#include <atomic>
+#include <chrono>
+#include <cstring>          // std::strcmp for stage names
+#include <iomanip>          // Column formatting for the report
+#include <mutex>            // Marks may come from worker threads (batch modes)
+#include <ostream>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+enum Phase { kOff, kRunning, kDone };
+
+struct Stage {
+    const char* name;
+    double ms;
+    bool idle;
+};
+
+std::atomic<int> phase{kOff};
+std::mutex mutex;
+std::vector<Stage> stages;
+Clock::time_point last;
+
+void closeStage(const char* stage, bool idle, int next) { // Caller holds the lock
+    const Clock::time_point now = Clock::now();
+    const double ms = std::chrono::duration<double, std::milli>(now - last).count();
+    auto it = std::find_if(stages.begin(), stages.end(), [&](const Stage& s) { return std::strcmp(s.name, stage) == 0; });
+    if (it != stages.end()) it->ms += ms; // A stage entered again (e.g. a reprompt) accumulates
+    else stages.push_back({stage, ms, idle});
+    last = now;
+    phase.store(next, std::memory_order_release);
+}
+} // namespace
+
+void StartupProfile::start() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stages.clear();
+    last = Clock::now();
+    phase.store(kRunning, std::memory_order_release);
+}
+
+bool StartupProfile::pending() {
+    return phase.load(std::memory_order_relaxed) == kRunning;
+}
+
+void StartupProfile::mark(const char* stage, bool idle) {
+    if (!pending()) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (phase.load(std::memory_order_relaxed) == kRunning) closeStage(stage, idle, kRunning);
+}
+
+void StartupProfile::finish(const char* stage) {
+    if (!pending()) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (phase.load(std::memory_order_relaxed) == kRunning) closeStage(stage, false, kDone);
+}
+
+void StartupProfile::report(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (phase.load(std::memory_order_relaxed) == kOff) return;
+    double work = 0.0, idle = 0.0;
+    out << "---- startup ----\n" << std::fixed << std::setprecision(3);
+    for (const Stage& s : stages) {
+        out << std::left << std::setw(28) << s.name << std::right << std::setw(12) << s.ms << " ms"
+            << (s.idle ? "  (idle)" : "") << "\n";
+        (s.idle ? idle : work) += s.ms;
+    }
+    if (phase.load(std::memory_order_relaxed) != kDone) out << "(no computerMove was reached)\n";
+    out << std::left << std::setw(28) << "total" << std::right << std::setw(12) << work << " ms";
+    if (idle > 0) out << " + " << idle << " ms idle";
+    out << "\n";
+    out.unsetf(std::ios::floatfield);
+}
@@ -0,0 +1,36 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <iosfwd> // std::ostream forward declaration
+
+// Wall-clock breakdown of process startup (--startup-profile).
+//
+// main() calls start() first and then mark()s the end of each setup stage.
+// Each mark charges the time since the previous one to the named stage. The
+// first computerMove() closes the timeline through a StartupProbe: the time
+// up to that call and the call itself become the last two stages. Stages
+// marked idle (a human typing) are listed but left out of the work total.
+// Before start() and after the first move, every call is a no-op apart from
+// one relaxed atomic load, so the probes can stay on the move path.
+class StartupProfile {
+public:
+    static void start();                                  // Begin the timeline
+    static bool pending();                                // Started, and no computerMove has finished yet
+    static void mark(const char* stage, bool idle = false);
+    static void finish(const char* stage);                // Final mark; later calls are ignored
+    static void report(std::ostream& out);                // Stage table; notes if no move was reached
+};
+
+// Top of computerMove(): times the first call as its own stage.
+class StartupProbe {
+public:
+    StartupProbe() : armed(StartupProfile::pending()) {
+        if (armed) StartupProfile::mark("until first computerMove");
+    }
+    ~StartupProbe() {
+        if (armed) StartupProfile::finish("first computerMove");
+    }
+    StartupProbe(const StartupProbe&) = delete;
+    StartupProbe& operator=(const StartupProbe&) = delete;
+
+private:
+    bool armed;
+};
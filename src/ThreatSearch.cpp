@@ -0,0 +1,87 @@
+#include "ThreatSearch.h" // Threat-space search declarations
+#include "Bits.h"         // popcount64 / lowestBit64
+#include "Profiler.h"     // Search node counter
+
+namespace {
+constexpr std::size_t kTableSize = 1u << 14; // Refutation table entries (power of two)
+}
+
+ThreatSearch::ThreatSearch(int depthLimit, std::uint64_t limit)
+    : maxDepth(depthLimit), nodeLimit(limit), refuted(kTableSize) {}
+
+ThreatSearch::Entry& ThreatSearch::slot(const QubicBoard& board) {
+    std::uint64_t h = board.marks('X') * 0x9E3779B97F4A7C15ULL ^ board.marks('O') * 0xC2B2AE3D27D4EB4FULL;
+    h ^= static_cast<std::uint64_t>(board.sideToMove());
+    return refuted[static_cast<std::size_t>(h >> 50) & (kTableSize - 1)];
+}
+
+bool ThreatSearch::attack(const QubicBoard& board, int depth, int* firstMove) {
+    if (++nodes > nodeLimit) return false; // Out of budget: report "no win found"
+    const char me = board.sideToMove();
+    const char opp = (me == 'X') ? 'O' : 'X';
+
+    if (std::uint64_t wins = board.winningCells(me)) { // Already one move from a line
+        if (firstMove) *firstMove = lowestBit64(wins);
+        return true;
+    }
+    const std::uint64_t oppWins = board.winningCells(opp);
+    if (popcount64(oppWins) > 1 || depth == 0) return false; // Cannot block two threats
+
+    Entry& e = slot(board);
+    if (e.depth >= depth && e.x == board.marks('X') && e.o == board.marks('O') && e.side == me) return false;
+
+    // Forced to block if the defender threatens; otherwise every threat-creating cell
+    const std::uint64_t candidates = oppWins ? oppWins : board.threatCells(me);
+    for (std::uint64_t rest = candidates; rest; rest &= rest - 1) {
+        const int cell = lowestBit64(rest);
+        QubicBoard afterAttack = board;
+        afterAttack.play(cell);
+        const std::uint64_t threats = afterAttack.winningCells(me);
+        if (!threats) continue;                           // Not forcing: the sequence ends here
+        if (afterAttack.winningCells(opp)) continue;      // Defender would complete a line instead of blocking
+        bool won = popcount64(threats) >= 2;              // Double threat: only one can be blocked
+        if (!won) {
+            QubicBoard afterBlock = afterAttack;
+            afterBlock.play(lowestBit64(threats));        // The defender's only reply
+            won = afterBlock.state() == GameState::RUNNING && attack(afterBlock, depth - 1, nullptr);
+        }
+        if (won) {
+            if (firstMove) *firstMove = cell;
+            return true;
+        }
+    }
+
+    if (nodes <= nodeLimit) { // Only a complete search proves a refutation
+        e.x = board.marks('X');
+        e.o = board.marks('O');
+        e.side = me;
+        e.depth = static_cast<std::int8_t>(depth);
+    }
+    return false;
+}
+
+bool ThreatSearch::findWin(const QubicBoard& board, int& firstMove) {
+    nodes = 0;
+    firstMove = -1;
+    bool found = board.state() == GameState::RUNNING && attack(board, maxDepth, &firstMove);
+    TTT_COUNT_N(Counter::SearchNodes, nodes);
+    return found;
+}
+
+std::uint64_t ThreatSearch::defendingMoves(const QubicBoard& board) {
+    const std::uint64_t empty = ~board.occupied();
+    const char opp = (board.sideToMove() == 'X') ? 'O' : 'X';
+    int move;
+    if (!findWin(board.withSideToMove(opp), move)) return empty; // Opponent has nothing forcing: any move will do
+
+    nodes = 0; // One shared budget for all replies; once spent, the rest count as safe
+    std::uint64_t safe = 0;
+    for (std::uint64_t rest = empty; rest; rest &= rest - 1) {
+        const int cell = lowestBit64(rest);
+        QubicBoard after = board;
+        after.play(cell);
+        if (after.state() != GameState::RUNNING || !attack(after, maxDepth, nullptr)) safe |= 1ULL << cell;
+    }
+    TTT_COUNT_N(Counter::SearchNodes, nodes);
+    return safe;
+}
@@ -0,0 +1,40 @@
+#pragma once // Ensure the header is included only once during compilation
+#include "QubicBoard.h" // QubicBoard
+#include <cstdint>
+#include <vector>
+
+// Threat-space search for Qubic.
+//
+// Looks for wins by continuous threats: the attacker only plays moves that
+// leave three in an open line (forcing the defender to block the fourth cell)
+// or that block a defender threat, and wins once a move creates two threats
+// at once. Because every defender reply is forced, the tree is a thin chain
+// and forced wins many plies deep are found long before a full-width search
+// would reach them. QubicSearch runs it before alpha-beta: a found win is
+// played directly, and when the opponent has one, the root is narrowed to the
+// moves that refute it.
+class ThreatSearch {
+public:
+    explicit ThreatSearch(int maxDepth = 24, std::uint64_t nodeLimit = 200000);
+
+    bool findWin(const QubicBoard& board, int& firstMove);  // Side to move wins by continuous threats?
+    std::uint64_t defendingMoves(const QubicBoard& board);  // Moves that leave the opponent no threat win;
+                                                            // all empty cells if none is needed, 0 if none helps
+    std::uint64_t lastNodes() const { return nodes; }
+
+private:
+    struct Entry { // Positions already refuted at some depth
+        std::uint64_t x = 0;
+        std::uint64_t o = 0;
+        char side = 0;
+        std::int8_t depth = -1;
+    };
+
+    int maxDepth;
+    std::uint64_t nodeLimit;
+    std::uint64_t nodes = 0;
+    std::vector<Entry> refuted;                             // Direct-mapped, allocated once
+
+    bool attack(const QubicBoard& board, int depth, int* firstMove);
+    Entry& slot(const QubicBoard& board);
+};
@@ -0,0 +1,452 @@
+#include "Tournament.h" // Tournament declarations
+#include "Bits.h"       // popcount64 / lowestBit64
+#include "Driver.h"     // TicTacToe as the match arbiter
+#include "MoveParser.h" // LineReader for the worker's job stream
+#include <algorithm>    // std::max / std::min / std::clamp
+#include <chrono>
+#include <cmath>        // std::log / std::log10 / std::sqrt
+#include <cstdio>       // std::snprintf / std::sscanf
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <thread>       // hardware_concurrency
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <csignal>      // Ignore SIGPIPE if a worker dies
+#include <poll.h>
+#include <sys/wait.h>   // waitpid
+#include <unistd.h>     // fork / pipe / read / write
+#endif
+
+namespace {
+constexpr long long kJobGames = 64;     // Games per job handed to a worker
+constexpr long long kReportEvery = 16;  // Worker reports after this many games
+constexpr int kJobsInFlight = 2;        // Per worker, so it never idles waiting for the next job
+
+// One side of a match: a Difficulty level playing from the current position.
+class MatchAgent {
+public:
+    MatchAgent(Difficulty level, std::uint64_t seed) : kind(level), rng(seed | 1) {}
+
+    int choose(std::uint16_t x, std::uint16_t o) {
+        if (kind != Difficulty::RANDOM) return agent.chooseMove(x, o, kind == Difficulty::PERFECT);
+        const std::uint16_t empty = static_cast<std::uint16_t>(TicTacToe::kFullMask & ~(x | o));
+        if (!empty) return -1;
+        rng ^= rng << 13; // xorshift64
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        int n = static_cast<int>(rng % static_cast<std::uint64_t>(popcount64(empty)));
+        std::uint64_t m = empty;
+        while (n-- > 0) m &= m - 1;
+        return lowestBit64(m);
+    }
+
+private:
+    Difficulty kind;
+    AdaptiveAgent agent; // Skill stays at its starting mix; matches do not call observe()
+    std::uint64_t rng;
+};
+
+// One game refereed by TicTacToe: every move must be available, and its GameState is the result.
+GameState playGame(TicTacToe& arbiter, MatchAgent& xAgent, MatchAgent& oAgent) {
+    arbiter.resetGame();
+    std::uint16_t x = 0, o = 0;
+    bool xToMove = true;
+    while (arbiter.getState() == GameState::RUNNING) {
+        int cell = (xToMove ? xAgent : oAgent).choose(x, o);
+        if (cell < 0 || !arbiter.isAvailable(cell / 3, cell % 3)) // Illegal move forfeits the game
+            return xToMove ? GameState::CPU_WIN : GameState::HUMAN_WIN;
+        arbiter.playerMove(cell / 3, cell % 3);
+        std::uint16_t& mine = xToMove ? x : o;
+        mine = static_cast<std::uint16_t>(mine | (1u << cell));
+        xToMove = !xToMove;
+    }
+    return arbiter.getState();
+}
+
+struct Tally {
+    long long games = 0, wins = 0, draws = 0, losses = 0;
+};
+
+// Plays `games` games of first vs second, alternating colours; report(tally) gets the deltas
+template <class Report>
+void playJob(Difficulty first, Difficulty second, long long games, std::uint64_t seed, Report report) {
+    TicTacToe arbiter;
+    MatchAgent a(first, seed * 2 + 1);
+    MatchAgent b(second, seed * 2 + 2);
+    Tally t;
+    for (long long g = 0; g < games; ++g) {
+        const bool firstIsX = (g % 2) == 0;
+        const GameState s = firstIsX ? playGame(arbiter, a, b) : playGame(arbiter, b, a);
+        const GameState firstWins = firstIsX ? GameState::HUMAN_WIN : GameState::CPU_WIN;
+        ++t.games;
+        if (s == GameState::TIE) ++t.draws;
+        else if (s == firstWins) ++t.wins;
+        else ++t.losses;
+        if (t.games == kReportEvery || g + 1 == games) {
+            report(t);
+            t = Tally{};
+        }
+    }
+}
+
+// ── Statistics ───────────────────────────────────────────────────────────
+
+double scoreOf(long long w, long long d, long long l) {
+    const long long n = w + d + l;
+    return n > 0 ? (static_cast<double>(w) + 0.5 * static_cast<double>(d)) / static_cast<double>(n) : 0.5;
+}
+
+double perGameVariance(long long w, long long d, long long l) {
+    const double n = static_cast<double>(w + d + l);
+    if (n <= 0) return 0.0;
+    const double s = scoreOf(w, d, l);
+    return (static_cast<double>(w) * (1 - s) * (1 - s) + static_cast<double>(d) * (0.5 - s) * (0.5 - s) +
+            static_cast<double>(l) * s * s) / n;
+}
+
+double eloFromScore(double s) {
+    s = std::clamp(s, 1e-3, 1 - 1e-3); // Shut-outs would be infinite; cap them at about +-1200
+    return -400.0 * std::log10(1.0 / s - 1.0);
+}
+
+double scoreFromElo(double elo) { return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0)); }
+
+struct EloEstimate {
+    double elo, low, high; // 95% interval from the normal approximation of the mean score
+};
+
+EloEstimate estimate(long long w, long long d, long long l) {
+    const double n = static_cast<double>(w + d + l);
+    const double s = scoreOf(w, d, l);
+    const double margin = n > 0 ? 1.96 * std::sqrt(perGameVariance(w, d, l) / n) : 0.5;
+    return {eloFromScore(s), eloFromScore(s - margin), eloFromScore(s + margin)};
+}
+
+// GSPRT with the normal approximation of the trinomial likelihood (as chess testing frameworks use)
+void updateSprt(PairResult& p, const TournamentOptions& o) {
+    const long long n = p.wins + p.draws + p.losses;
+    if (n == 0) return;
+    const double s0 = scoreFromElo(o.sprtElo0), s1 = scoreFromElo(o.sprtElo1);
+    const double var = std::max(perGameVariance(p.wins, p.draws, p.losses), 1e-6); // All draws: still decide
+    const double s = scoreOf(p.wins, p.draws, p.losses);
+    p.llr = static_cast<double>(n) * (s1 - s0) * (2 * s - s0 - s1) / (2 * var);
+    const double lower = std::log(o.sprtBeta / (1 - o.sprtAlpha));
+    const double upper = std::log((1 - o.sprtBeta) / o.sprtAlpha);
+    if (p.sprt != 0) return; // The first crossing is the decision; the LLR keeps tracking the data
+    if (p.llr >= upper) p.sprt = 1;
+    else if (p.llr <= lower) p.sprt = -1;
+}
+
+// ── Scheduling ───────────────────────────────────────────────────────────
+
+struct Job {
+    int pair;
+    long long games;
+    long long reported = 0;
+    std::uint64_t seed;
+};
+
+class Schedule {
+public:
+    Schedule(const TournamentOptions& opts, std::ostream& log) : options(opts), progress(log) {
+        for (std::size_t i = 0; i < opts.agents.size(); ++i)
+            for (std::size_t j = i + 1; j < opts.agents.size(); ++j) {
+                PairResult p;
+                p.first = opts.agents[i];
+                p.second = opts.agents[j];
+                pairs.push_back(p);
+                scheduled.push_back(0);
+            }
+    }
+
+    int next() { // Job id, or -1 when every pair is decided or fully scheduled
+        for (std::size_t k = 0; k < pairs.size(); ++k) {
+            const int p = static_cast<int>((cursor + k) % pairs.size());
+            const long long left = options.gamesPerPair - scheduled[static_cast<std::size_t>(p)];
+            if ((options.sprtStop && pairs[static_cast<std::size_t>(p)].sprt != 0) || left <= 0) continue;
+            cursor = static_cast<std::size_t>(p) + 1;
+            const long long games = std::min(kJobGames, left);
+            scheduled[static_cast<std::size_t>(p)] += games;
+            jobs.push_back({p, games, 0, options.seed * 0x9E3779B97F4A7C15ULL + jobs.size()});
+            return static_cast<int>(jobs.size() - 1);
+        }
+        return -1;
+    }
+
+    bool record(int jobId, const Tally& t) { // True once the job has reported all its games
+        Job& job = jobs[static_cast<std::size_t>(jobId)];
+        PairResult& p = pairs[static_cast<std::size_t>(job.pair)];
+        p.wins += t.wins;
+        p.draws += t.draws;
+        p.losses += t.losses;
+        job.reported += t.games;
+        const int before = p.sprt;
+        updateSprt(p, options);
+        if (p.sprt != before)
+            progress << Tournament::agentName(p.first) << " vs " << Tournament::agentName(p.second) << ": SPRT "
+                     << (p.sprt > 0 ? "H1" : "H0") << (options.sprtStop ? " (stopping)" : "") << " after " << (p.wins + p.draws + p.losses) << " games\n";
+        return job.reported >= job.games;
+    }
+
+    long long requeue(int jobId) { // Hands a dead worker's unreported games back to next(); returns their count
+        Job& job = jobs[static_cast<std::size_t>(jobId)];
+        const long long left = job.games - job.reported;
+        scheduled[static_cast<std::size_t>(job.pair)] -= left;
+        job.games = job.reported;
+        return left;
+    }
+
+    long long unplayed() const { // Games still owed to undecided pairs
+        long long n = 0;
+        for (std::size_t p = 0; p < pairs.size(); ++p)
+            if (!(options.sprtStop && pairs[p].sprt != 0)) n += options.gamesPerPair - scheduled[p];
+        return n;
+    }
+
+    const Job& job(int id) const { return jobs[static_cast<std::size_t>(id)]; }
+    const PairResult& pair(int id) const { return pairs[static_cast<std::size_t>(id)]; }
+    std::vector<PairResult> results() const { return pairs; }
+
+private:
+    const TournamentOptions& options;
+    std::ostream& progress;
+    std::vector<PairResult> pairs;
+    std::vector<long long> scheduled;
+    std::vector<Job> jobs;
+    std::size_t cursor = 0;
+};
+
+#if !defined(_WIN32)
+
+void writeAll(int fd, const std::string& text) {
+    const char* p = text.data();
+    std::size_t left = text.size();
+    while (left > 0) {
+        ssize_t n = ::write(fd, p, left);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return;
+        p += n;
+        left -= static_cast<std::size_t>(n);
+    }
+}
+
+// Worker process: "J id first second games seed" lines in, "R id games wins draws losses" lines out.
+[[noreturn]] void workerMain(int jobFd, int resultFd) {
+    AdaptiveAgent::prepare();
+    LineReader jobs(jobFd, 4096);
+    while (auto line = jobs.next()) {
+        std::string text(*line);
+        int id = 0, first = 0, second = 0;
+        long long games = 0;
+        unsigned long long seed = 0;
+        if (std::sscanf(text.c_str(), "J %d %d %d %lld %llu", &id, &first, &second, &games, &seed) != 5) continue;
+        playJob(static_cast<Difficulty>(first), static_cast<Difficulty>(second), games, seed, [&](const Tally& t) {
+            char out[96];
+            int n = std::snprintf(out, sizeof out, "R %d %lld %lld %lld %lld\n", id, t.games, t.wins, t.draws, t.losses);
+            writeAll(resultFd, std::string(out, static_cast<std::size_t>(n)));
+        });
+    }
+    ::_exit(0);
+}
+
+struct WorkerProcess {
+    pid_t pid = -1;
+    int jobFd = -1;     // Coordinator writes jobs here
+    int resultFd = -1;  // ... and reads results here
+    std::string pending; // Partial result line
+    std::vector<int> inFlight; // Job ids dispatched but not fully reported
+};
+
+bool spawnWorkers(int count, std::vector<WorkerProcess>& workers) {
+    for (int w = 0; w < count; ++w) {
+        int jobPipe[2], resultPipe[2];
+        if (::pipe(jobPipe) != 0) return false;
+        if (::pipe(resultPipe) != 0) {
+            ::close(jobPipe[0]);
+            ::close(jobPipe[1]);
+            return false;
+        }
+        pid_t pid = ::fork();
+        if (pid < 0) return false;
+        if (pid == 0) {
+            for (const auto& other : workers) { // Earlier workers must see EOF when the coordinator closes their pipe
+                ::close(other.jobFd);
+                ::close(other.resultFd);
+            }
+            ::close(jobPipe[1]);
+            ::close(resultPipe[0]);
+            workerMain(jobPipe[0], resultPipe[1]);
+        }
+        ::close(jobPipe[0]);
+        ::close(resultPipe[1]);
+        WorkerProcess wp;
+        wp.pid = pid;
+        wp.jobFd = jobPipe[1];
+        wp.resultFd = resultPipe[0];
+        workers.push_back(std::move(wp));
+    }
+    return true;
+}
+
+void dispatch(Schedule& schedule, WorkerProcess& w) {
+    while (static_cast<int>(w.inFlight.size()) < kJobsInFlight) {
+        const int id = schedule.next();
+        if (id < 0) return;
+        const Job& job = schedule.job(id);
+        const PairResult& p = schedule.pair(job.pair);
+        char line[128];
+        int n = std::snprintf(line, sizeof line, "J %d %d %d %lld %llu\n", id, static_cast<int>(p.first),
+                              static_cast<int>(p.second), job.games, static_cast<unsigned long long>(job.seed));
+        writeAll(w.jobFd, std::string(line, static_cast<std::size_t>(n)));
+        w.inFlight.push_back(id);
+    }
+}
+
+int runDistributed(Schedule& schedule, int count, std::ostream& progress) {
+    std::signal(SIGPIPE, SIG_IGN);
+    std::vector<WorkerProcess> workers;
+    workers.reserve(static_cast<std::size_t>(count));
+    if (!spawnWorkers(count, workers)) count = static_cast<int>(workers.size());
+
+    std::vector<pollfd> fds;
+    char chunk[4096];
+    for (;;) {
+        fds.clear();
+        for (auto& w : workers) {
+            if (w.resultFd < 0) continue;
+            dispatch(schedule, w);
+            if (!w.inFlight.empty()) fds.push_back({w.resultFd, POLLIN, 0});
+        }
+        if (fds.empty()) { // Nothing scheduled and nothing outstanding, or no worker left to take it
+            if (const long long left = schedule.unplayed(); left > 0)
+                progress << "No workers left; " << left << " games not played\n";
+            break;
+        }
+
+        if (::poll(fds.data(), static_cast<nfds_t>(fds.size()), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        for (const pollfd& p : fds) {
+            if (!p.revents) continue;
+            auto& w = *std::find_if(workers.begin(), workers.end(), [&](const WorkerProcess& wp) { return wp.resultFd == p.fd; });
+            ssize_t n = ::read(w.resultFd, chunk, sizeof chunk);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) { // Worker died; the survivors pick up its unreported games
+                long long lost = 0;
+                for (int id : w.inFlight) lost += schedule.requeue(id);
+                w.inFlight.clear();
+                if (lost > 0) progress << "Worker " << w.pid << " died; re-dispatching " << lost << " games\n";
+                ::close(w.resultFd);
+                w.resultFd = -1;
+                continue;
+            }
+            w.pending.append(chunk, static_cast<std::size_t>(n));
+            std::size_t nl;
+            while ((nl = w.pending.find('\n')) != std::string::npos) {
+                int id = 0;
+                Tally t;
+                if (std::sscanf(w.pending.c_str(), "R %d %lld %lld %lld %lld", &id, &t.games, &t.wins, &t.draws, &t.losses) == 5 &&
+                    schedule.record(id, t))
+                    std::erase(w.inFlight, id);
+                w.pending.erase(0, nl + 1);
+            }
+        }
+    }
+
+    for (auto& w : workers) { // EOF on the job pipe ends each worker
+        ::close(w.jobFd);
+        if (w.resultFd >= 0) ::close(w.resultFd);
+        int status = 0;
+        ::waitpid(w.pid, &status, 0);
+    }
+    return count;
+}
+
+#endif
+} // namespace
+
+const char* Tournament::agentName(Difficulty agent) {
+    switch (agent) {
+    case Difficulty::RANDOM:   return "random";
+    case Difficulty::ADAPTIVE: return "adaptive";
+    case Difficulty::PERFECT:  return "perfect";
+    }
+    return "?";
+}
+
+bool Tournament::parseAgents(const std::string& list, std::vector<Difficulty>& out) {
+    out.clear();
+    std::istringstream in(list);
+    std::string name;
+    while (std::getline(in, name, ',')) {
+        if (name == "random") out.push_back(Difficulty::RANDOM);
+        else if (name == "adaptive") out.push_back(Difficulty::ADAPTIVE);
+        else if (name == "perfect") out.push_back(Difficulty::PERFECT);
+        else return false;
+        if (std::count(out.begin(), out.end(), out.back()) > 1) return false; // Agents are told apart by level
+    }
+    return out.size() >= 2;
+}
+
+TournamentStats Tournament::run(const TournamentOptions& options, std::ostream& progress) {
+    TournamentStats stats;
+    stats.agents = options.agents;
+    Schedule schedule(options, progress);
+    auto start = std::chrono::steady_clock::now();
+
+#if !defined(_WIN32)
+    int workers = options.workers > 0 ? options.workers : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    stats.workers = runDistributed(schedule, workers, progress);
+#else
+    AdaptiveAgent::prepare();
+    for (int id = schedule.next(); id >= 0; id = schedule.next()) { // In-process: no fork() here
+        const Job& job = schedule.job(id);
+        const PairResult& p = schedule.pair(job.pair);
+        playJob(p.first, p.second, job.games, job.seed, [&](const Tally& t) { schedule.record(id, t); });
+    }
+    stats.workers = 0;
+#endif
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats.pairs = schedule.results();
+    return stats;
+}
+
+void Tournament::printSummary(const TournamentStats& stats, std::ostream& out) {
+    long long total = 0;
+    for (const auto& p : stats.pairs) total += p.wins + p.draws + p.losses;
+    out << "Tournament: " << stats.agents.size() << " agents, " << stats.workers << " worker processes, " << total
+        << " games in " << std::fixed << std::setprecision(3) << stats.seconds << " s\n";
+
+    out << std::setprecision(1);
+    out << std::left << std::setw(22) << "Pair" << std::right << std::setw(8) << "Games" << std::setw(7) << "W"
+        << std::setw(7) << "D" << std::setw(7) << "L" << std::setw(9) << "Elo" << "  95% CI            SPRT\n";
+    for (const auto& p : stats.pairs) {
+        const EloEstimate e = estimate(p.wins, p.draws, p.losses);
+        const std::string name = std::string(agentName(p.first)) + " vs " + agentName(p.second);
+        out << std::left << std::setw(22) << name << std::right << std::setw(8) << (p.wins + p.draws + p.losses)
+            << std::setw(7) << p.wins << std::setw(7) << p.draws << std::setw(7) << p.losses << std::setw(9) << e.elo
+            << "  [" << std::setw(7) << e.low << ", " << std::setw(7) << e.high << "]  "
+            << (p.sprt > 0 ? "H1" : p.sprt < 0 ? "H0" : "--") << " (LLR " << std::setprecision(2) << p.llr << ")\n"
+            << std::setprecision(1);
+    }
+
+    out << std::left << std::setw(22) << "Agent vs field" << std::right << std::setw(8) << "Games" << std::setw(9)
+        << "Score" << std::setw(9) << "Elo" << "  95% CI\n";
+    for (Difficulty agent : stats.agents) {
+        long long w = 0, d = 0, l = 0;
+        for (const auto& p : stats.pairs) {
+            if (p.first == agent) { w += p.wins; d += p.draws; l += p.losses; }
+            if (p.second == agent) { w += p.losses; d += p.draws; l += p.wins; }
+        }
+        const EloEstimate e = estimate(w, d, l);
+        out << std::left << std::setw(22) << agentName(agent) << std::right << std::setw(8) << (w + d + l)
+            << std::setw(9) << std::setprecision(3) << scoreOf(w, d, l) << std::setprecision(1) << std::setw(9) << e.elo
+            << "  [" << std::setw(7) << e.low << ", " << std::setw(7) << e.high << "]\n";
+    }
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
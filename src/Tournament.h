@@ -0,0 +1,59 @@
+#pragma once // Ensure the header is included only once during compilation
+#include "AdaptiveAgent.h" // Difficulty doubles as the agent id
+#include <iosfwd>          // std::ostream forward declaration
+#include <string>
+#include <vector>
+
+// Tournament settings (--tournament).
+struct TournamentOptions {
+    std::vector<Difficulty> agents;  // Round robin over every pair
+    long long gamesPerPair = 1000;   // Upper bound; SPRT may stop a pair earlier
+    int workers = 0;                 // Worker processes (<= 0: hardware concurrency)
+    bool sprtStop = false;           // Stop a pair once its SPRT decides (otherwise the decision is only reported)
+    double sprtElo0 = 0.0;           // H0: the first agent is this much stronger
+    double sprtElo1 = 20.0;          // H1: ... or at least this much
+    double sprtAlpha = 0.05;
+    double sprtBeta = 0.05;
+    unsigned long long seed = 1;
+};
+
+// Outcome of one pairing, from `first`'s point of view.
+struct PairResult {
+    Difficulty first;
+    Difficulty second;
+    long long wins = 0;
+    long long draws = 0;
+    long long losses = 0;
+    double llr = 0.0;      // SPRT log-likelihood ratio
+    int sprt = 0;          // +1 H1 accepted, -1 H0 accepted, 0 undecided
+};
+
+struct TournamentStats {
+    std::vector<PairResult> pairs;
+    std::vector<Difficulty> agents;
+    int workers = 0;
+    double seconds = 0.0;
+};
+
+// Round-robin coordinator for agent-vs-agent 3x3 matches.
+//
+// Matches are cut into small jobs and handed out to worker processes that
+// are forked at start. Jobs go down a pipe to each worker as text lines, and
+// the worker sends results back every few games. The coordinator poll()s the
+// result pipes, folds each report into the pair's tally, and re-evaluates
+// that pair's SPRT. With sprtStop set, a pair that has reached a decision gets
+// no further jobs.
+//
+// Every game is refereed by a TicTacToe instance: a move must pass
+// isAvailable, and playerMove's GameState decides the result. Colours
+// alternate from game to game, because X moves first and that is a large
+// advantage in this game.
+//
+// Windows has no fork(), so jobs there run inline in the coordinator.
+class Tournament {
+public:
+    static TournamentStats run(const TournamentOptions& options, std::ostream& progress);
+    static void printSummary(const TournamentStats& stats, std::ostream& out);
+    static bool parseAgents(const std::string& list, std::vector<Difficulty>& out); // "random,adaptive,perfect"
+    static const char* agentName(Difficulty agent);
+};
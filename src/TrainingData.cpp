@@ -0,0 +1,247 @@
+#include "TrainingData.h" // Self-play data declarations
+#include "Driver.h"       // TicTacToe::hasLine / kFullMask
+#include "Solver.h"       // Values, move values and base-3 index
+#include "Bits.h"         // popcount64
+#include <algorithm>      // std::max / std::min
+#include <atomic>         // Shared game/shard counters and the dedup set
+#include <chrono>
+#include <cmath>          // std::exp for the softmax
+#include <cstdio>         // std::snprintf / std::sscanf for shard names
+#include <cstring>        // std::memcmp for the file magic
+#include <filesystem>
+#include <fstream>
+#include <mutex>          // Serialized progress log
+#include <ostream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr char kMagic[4] = {'T', 'T', 'T', 'D'};
+constexpr std::uint32_t kVersion = 1;
+
+struct ShardHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint32_t records;
+    std::uint64_t games;
+};
+
+// The eight symmetries of the square as cell permutations (row*3 + col).
+constexpr int kSymmetry[8][9] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8}, // Identity
+    {6, 3, 0, 7, 4, 1, 8, 5, 2}, // Rotate 90
+    {8, 7, 6, 5, 4, 3, 2, 1, 0}, // Rotate 180
+    {2, 5, 8, 1, 4, 7, 0, 3, 6}, // Rotate 270
+    {2, 1, 0, 5, 4, 3, 8, 7, 6}, // Mirror columns
+    {6, 7, 8, 3, 4, 5, 0, 1, 2}, // Mirror rows
+    {0, 3, 6, 1, 4, 7, 2, 5, 8}, // Main diagonal
+    {8, 5, 2, 7, 4, 1, 6, 3, 0}, // Anti-diagonal
+};
+
+std::uint16_t transform(int symmetry, std::uint16_t mask) {
+    std::uint16_t out = 0;
+    for (int cell = 0; cell < 9; ++cell)
+        if ((mask >> cell) & 1) out = static_cast<std::uint16_t>(out | (1u << kSymmetry[symmetry][cell]));
+    return out;
+}
+
+std::string shardName(int shard) {
+    char name[32];
+    std::snprintf(name, sizeof name, "shard-%05d.tttd", shard);
+    return name;
+}
+} // namespace
+
+int TrainingData::mapCell(int symmetry, int cell) {
+    return kSymmetry[symmetry][cell];
+}
+
+int TrainingData::canonicalize(std::uint16_t& x, std::uint16_t& o) {
+    int best = 0;
+    int bestIndex = Solver::index(x, o);
+    for (int s = 1; s < 8; ++s) {
+        int idx = Solver::index(transform(s, x), transform(s, o));
+        if (idx < bestIndex) {
+            bestIndex = idx;
+            best = s;
+        }
+    }
+    x = transform(best, x);
+    o = transform(best, o);
+    return best;
+}
+
+bool TrainingData::readShard(const std::string& path, std::vector<DataRecord>& records, long long& games) {
+    std::ifstream in(path, std::ios::binary);
+    ShardHeader h;
+    if (!in.read(reinterpret_cast<char*>(&h), sizeof h)) return false;
+    if (std::memcmp(h.magic, kMagic, 4) != 0 || h.version != kVersion || h.recordSize != sizeof(DataRecord)) return false;
+    records.resize(h.records);
+    if (!in.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(h.records * sizeof(DataRecord))))
+        return false;
+    games = static_cast<long long>(h.games);
+    return true;
+}
+
+DataGenStats TrainingData::generate(const std::string& dir, long long games, int threads, std::ostream& log,
+                                    int shardRecords, double temperature) {
+    const auto start = std::chrono::steady_clock::now();
+    DataGenStats stats;
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+
+    // Resume: drop half-written shards, then rebuild the counters and the dedup set from the committed ones.
+    std::vector<std::atomic<bool>> seen(Solver::kPositions);
+    int nextShard = 0;
+    for (const auto& entry : fs::directory_iterator(dir, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (entry.path().extension() == ".tmp") {
+            fs::remove(entry.path(), ec);
+            continue;
+        }
+        int shard;
+        if (std::sscanf(name.c_str(), "shard-%d.tttd", &shard) != 1) continue;
+        std::vector<DataRecord> records;
+        long long shardGames = 0;
+        if (!readShard(entry.path().string(), records, shardGames)) {
+            log << "Skipping unreadable shard " << name << "\n";
+            continue;
+        }
+        for (const DataRecord& r : records) seen[static_cast<size_t>(Solver::index(r.x, r.o))] = true;
+        stats.games += shardGames;
+        stats.records += static_cast<long long>(records.size());
+        nextShard = std::max(nextShard, shard + 1);
+        ++stats.shards;
+    }
+    if (stats.games > 0) log << "Resuming after " << stats.games << " games (" << stats.records << " records)\n";
+
+    const long long remaining = games - stats.games;
+    if (remaining <= 0) {
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return stats;
+    }
+    if (threads <= 0) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    if (remaining < threads) threads = static_cast<int>(remaining);
+
+    std::atomic<long long> claimed{0};       // Games handed out this run
+    std::atomic<int> shardCounter{nextShard};
+    std::atomic<long long> committedGames{stats.games};
+    std::atomic<long long> committedRecords{stats.records};
+    std::atomic<long long> duplicates{0};
+    std::atomic<int> shardsWritten{0};
+    std::mutex logMutex;
+
+    auto worker = [&](int id) {
+        std::uint64_t rng = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) ^
+                            (0x9E3779B97F4A7C15ULL * static_cast<std::uint64_t>(id + 1));
+        auto uniform = [&rng] { // [0, 1)
+            rng ^= rng << 13;
+            rng ^= rng >> 7;
+            rng ^= rng << 17;
+            return static_cast<double>(rng >> 11) * (1.0 / 9007199254740992.0);
+        };
+
+        std::vector<DataRecord> buffer;
+        long long bufferGames = 0;
+        auto commit = [&] { // Write the buffer as one shard: .tmp first, renamed once complete
+            if (bufferGames == 0) return;
+            const int shard = shardCounter.fetch_add(1);
+            const fs::path final = fs::path(dir) / shardName(shard);
+            const fs::path tmp = fs::path(final.string() + ".tmp");
+            {
+                std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+                ShardHeader h{{kMagic[0], kMagic[1], kMagic[2], kMagic[3]}, kVersion, sizeof(DataRecord),
+                              static_cast<std::uint32_t>(buffer.size()), static_cast<std::uint64_t>(bufferGames)};
+                out.write(reinterpret_cast<const char*>(&h), sizeof h);
+                out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(DataRecord)));
+            }
+            std::error_code renameError;
+            fs::rename(tmp, final, renameError);
+            if (renameError) {
+                std::lock_guard<std::mutex> lock(logMutex);
+                log << "Cannot commit " << final.string() << ": " << renameError.message() << "\n";
+                return; // Keep the buffer; the final commit() tries again
+            }
+            committedGames += bufferGames;
+            committedRecords += static_cast<long long>(buffer.size());
+            ++shardsWritten;
+            {
+                std::lock_guard<std::mutex> lock(logMutex);
+                log << final.filename().string() << ": " << buffer.size() << " records from " << bufferGames << " games\n";
+            }
+            buffer.clear();
+            bufferGames = 0;
+        };
+
+        std::vector<DataRecord> game;
+        while (claimed.fetch_add(1) < remaining) {
+            game.clear();
+            std::uint16_t x = 0, o = 0;
+            GameState state = GameState::RUNNING;
+            while (state == GameState::RUNNING) {
+                const bool xToMove = popcount64(x) == popcount64(o);
+
+                // Softmax over the solved move values
+                double weight[9] = {};
+                double total = 0.0;
+                int best = -100;
+                for (int cell = 0; cell < 9; ++cell) best = std::max(best, Solver::moveValue(x, o, cell));
+                for (int cell = 0; cell < 9; ++cell) {
+                    int v = Solver::moveValue(x, o, cell);
+                    if (v == Solver::kUnreachable) continue;
+                    weight[cell] = std::exp((v - best) / temperature);
+                    total += weight[cell];
+                }
+
+                DataRecord r;
+                r.toMove = xToMove ? 'X' : 'O';
+                r.value = static_cast<std::int8_t>(Solver::value(x, o));
+                std::uint16_t cx = x, co = o;
+                const int sym = canonicalize(cx, co);
+                r.x = cx;
+                r.o = co;
+                for (int cell = 0; cell < 9; ++cell)
+                    r.policy[static_cast<size_t>(mapCell(sym, cell))] = static_cast<std::uint8_t>(std::lround(255.0 * weight[cell] / total));
+                game.push_back(r);
+
+                double pick = uniform() * total;
+                int move = -1;
+                for (int cell = 0; cell < 9; ++cell) {
+                    if (weight[cell] <= 0.0) continue;
+                    move = cell;
+                    if ((pick -= weight[cell]) < 0.0) break;
+                }
+                const std::uint16_t bit = static_cast<std::uint16_t>(1u << move);
+                if (xToMove) x = static_cast<std::uint16_t>(x | bit);
+                else o = static_cast<std::uint16_t>(o | bit);
+                if (TicTacToe::hasLine(x)) state = GameState::HUMAN_WIN;
+                else if (TicTacToe::hasLine(o)) state = GameState::CPU_WIN;
+                else if ((x | o) == TicTacToe::kFullMask) state = GameState::TIE;
+            }
+
+            for (DataRecord& r : game) { // Label with the result, then keep only positions not seen before
+                if (state == GameState::TIE) r.outcome = 0;
+                else r.outcome = (state == GameState::HUMAN_WIN) == (r.toMove == 'X') ? 1 : -1;
+                if (seen[static_cast<size_t>(Solver::index(r.x, r.o))].exchange(true)) ++duplicates;
+                else buffer.push_back(r);
+            }
+            ++bufferGames;
+            if (static_cast<int>(buffer.size()) >= shardRecords) commit();
+        }
+        commit(); // Whatever is left, so the game count is complete
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+
+    stats.games = committedGames;
+    stats.records = committedRecords;
+    stats.duplicates = duplicates;
+    stats.shards += shardsWritten;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
@@ -0,0 +1,52 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <array>
+#include <cstdint>
+#include <iosfwd> // std::ostream forward declaration
+#include <string>
+#include <vector>
+
+// Labelled 3x3 positions from self-play, for training learned evaluators.
+//
+// Records are fixed 16-byte structs in TicTacToe's bit layout, stored in the
+// canonical orientation (the smallest Solver::index among the board's eight
+// rotations and reflections). Each position is written once per run. The
+// dedup set is rebuilt from the committed shards on resume, so it survives
+// restarts as well.
+struct DataRecord {
+    std::uint16_t x = 0;                    // X cell mask
+    std::uint16_t o = 0;                    // O cell mask
+    char toMove = 'X';                      // Side to move
+    std::int8_t value = 0;                  // Solver value for the side to move
+    std::int8_t outcome = 0;                // Final result for the side to move: +1 win, 0 tie, -1 loss
+    std::array<std::uint8_t, 9> policy{};   // Move distribution played from here, sums to ~255
+};
+static_assert(sizeof(DataRecord) == 16, "records are written to disk as-is");
+
+struct DataGenStats {
+    long long games = 0;                    // Games committed to shards (including earlier runs)
+    long long records = 0;                  // Records committed (including earlier runs)
+    long long duplicates = 0;               // Positions dropped by this run as already recorded
+    int shards = 0;                         // Shard files in the directory when done
+    double seconds = 0.0;                   // Wall time of this run
+};
+
+// Self-play generator. Both sides sample moves from a softmax over
+// Solver::moveValue, so games stay near perfect play but still cover
+// mistakes. That softmax is the policy stored with each record.
+//
+// Output goes to dir/shard-NNNNN.tttd: a header (magic "TTTD", version,
+// record size, record count, games) followed by the records. Every worker
+// buffers whole games and writes a shard once it holds shardRecords
+// records. The shard is written as a .tmp file and renamed, so an
+// interrupted run leaves only complete shards. Running again with the same
+// directory and game target continues from the committed games.
+class TrainingData {
+public:
+    static DataGenStats generate(const std::string& dir, long long games, int threads, std::ostream& log,
+                                 int shardRecords = 4096, double temperature = 2.0);
+
+    static bool readShard(const std::string& path, std::vector<DataRecord>& records, long long& games);
+
+    static int canonicalize(std::uint16_t& x, std::uint16_t& o); // Rewrites to canonical form, returns the symmetry used
+    static int mapCell(int symmetry, int cell);                  // Where cell lands under that symmetry
+};
@@ -0,0 +1,73 @@
+#include "Ultimate.h" // Ultimate board declarations
+
+// ──────────────────────────────────────────────────────────────
+// UltimateBoard
+void UltimateBoard::reset() {
+    *this = UltimateBoard{};
+}
+
+bool UltimateBoard::isLegal(int move) const {
+    if (status != GameState::RUNNING || move < 0 || move >= kCells) return false;
+    int sub = move / 9;
+    int cell = move % 9;
+    if ((closedSubs() >> sub) & 1) return false;            // Sub-board already decided
+    if (forced != kAnySub && sub != forced) return false;   // Must answer in the sub-board we were sent to
+    return !(((xCells[sub] | oCells[sub]) >> cell) & 1);    // Cell must be empty
+}
+
+int UltimateBoard::legalMoves(std::array<std::uint8_t, kCells>& out) const {
+    if (status != GameState::RUNNING) return 0;
+    int n = 0;
+    auto emit = [&](int sub) { // Append every empty cell of one sub-board
+        std::uint16_t taken = static_cast<std::uint16_t>(xCells[sub] | oCells[sub]);
+        for (int c = 0; c < 9; ++c)
+            if (!((taken >> c) & 1)) out[n++] = static_cast<std::uint8_t>(sub * 9 + c);
+    };
+    if (forced != kAnySub) {
+        emit(forced);
+    } else {
+        std::uint16_t closed = closedSubs();
+        for (int sub = 0; sub < 9; ++sub)
+            if (!((closed >> sub) & 1)) emit(sub);
+    }
+    return n;
+}
+
+bool UltimateBoard::play(int move) {
+    if (!isLegal(move)) return false;
+    int sub = move / 9;
+    int cell = move % 9;
+    std::uint16_t subBit = static_cast<std::uint16_t>(1u << sub);
+
+    std::uint16_t& mine = (side == 'X') ? xCells[sub] : oCells[sub];
+    mine = static_cast<std::uint16_t>(mine | (1u << cell));
+    if (TicTacToe::hasLine(mine)) { // Sub-board won: claim its macro cell
+        std::uint16_t& macro = (side == 'X') ? macroX : macroO;
+        macro = static_cast<std::uint16_t>(macro | subBit);
+    } else if ((xCells[sub] | oCells[sub]) == TicTacToe::kFullMask) {
+        macroDrawn = static_cast<std::uint16_t>(macroDrawn | subBit);
+    }
+
+    if (TicTacToe::hasLine(macroX)) status = GameState::HUMAN_WIN;
+    else if (TicTacToe::hasLine(macroO)) status = GameState::CPU_WIN;
+    else if (closedSubs() == TicTacToe::kFullMask) status = GameState::TIE;
+
+    forced = ((closedSubs() >> cell) & 1) ? static_cast<std::int8_t>(kAnySub) : static_cast<std::int8_t>(cell); // The send rule
+    side = (side == 'X') ? 'O' : 'X';
+    return true;
+}
+
+char UltimateBoard::cellAt(int move) const {
+    int sub = move / 9;
+    int cell = move % 9;
+    if ((xCells[sub] >> cell) & 1) return 'X';
+    if ((oCells[sub] >> cell) & 1) return 'O';
+    return ' ';
+}
+
+char UltimateBoard::subOwner(int sub) const {
+    if ((macroX >> sub) & 1) return 'X';
+    if ((macroO >> sub) & 1) return 'O';
+    if ((macroDrawn >> sub) & 1) return 'T';
+    return ' ';
+}
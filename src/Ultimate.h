@@ -0,0 +1,48 @@
+#pragma once // Ensure the header is included only once during compilation
+#include "Driver.h" // GameState, TicTacToe mask rules reused for every sub-board
+#include "Mcts.h"   // Generic MCTS agent
+#include <array>
+#include <cstdint>
+
+// Ultimate (meta) Tic-Tac-Toe.
+//
+// Nine 3x3 sub-boards laid out in a 3x3 macro grid. A move is encoded as
+// sub*9 + cell, where both sub and cell use TicTacToe's bit layout
+// (row*3 + col). Playing cell c sends the opponent to sub-board c; if that
+// sub-board is already decided they may play in any open sub-board. Winning a
+// sub-board claims its macro cell, and three claimed macro cells in a line win.
+// Sub-board and macro win detection both go through TicTacToe::hasLine.
+class UltimateBoard {
+public:
+    static constexpr int kCells = 81;
+    static constexpr const char* kName = "ultimate";
+    static constexpr int kAnySub = -1;
+
+    UltimateBoard() = default;
+
+    void reset();                                       // Empty board, X to move, no forced sub-board
+    int legalMoves(std::array<std::uint8_t, kCells>& out) const; // Fills out, returns count
+    bool isLegal(int move) const;
+    bool play(int move);                                // Applies a legal move; false (no change) otherwise
+
+    GameState state() const { return status; }          // HUMAN_WIN = X, CPU_WIN = O
+    char sideToMove() const { return side; }
+    int forcedSub() const { return forced; }            // Sub-board the next move must use, or kAnySub
+    char cellAt(int move) const;                        // 'X', 'O' or ' '
+    char subOwner(int sub) const;                       // 'X', 'O', 'T' (drawn) or ' ' (open)
+
+private:
+    std::array<std::uint16_t, 9> xCells{};              // Per sub-board X masks
+    std::array<std::uint16_t, 9> oCells{};              // Per sub-board O masks
+    std::uint16_t macroX = 0;                           // Sub-boards won by X
+    std::uint16_t macroO = 0;                           // Sub-boards won by O
+    std::uint16_t macroDrawn = 0;                       // Sub-boards filled without a winner
+    std::int8_t forced = kAnySub;
+    char side = 'X';
+    GameState status = GameState::RUNNING;
+
+    std::uint16_t closedSubs() const { return static_cast<std::uint16_t>(macroX | macroO | macroDrawn); }
+};
+
+// Monte-Carlo tree search agent (see Mcts.h).
+using UltimateMcts = Mcts<UltimateBoard>;
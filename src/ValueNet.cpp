@@ -0,0 +1,271 @@
+#include "ValueNet.h" // Value network declarations
+#include "AllocProfile.h" // Weights are charged to the network tag
+#include "Bits.h"     // lowestBit64 for feature extraction
+#include "Profiler.h" // Evaluation counter
+#include "Qubic.h"    // QubicSearch::evaluate as the distillation target
+#include <algorithm>  // std::min / std::max / std::clamp
+#include <bit>        // std::endian for the weight file layout
+#include <cmath>      // std::tanh, std::lround
+#include <cstring>    // std::memcmp for the file magic
+#include <fstream>
+
+namespace {
+constexpr char kMagic[4] = {'T', 'T', 'T', 'N'};
+static_assert(std::endian::native == std::endian::little, "TTTN files are little-endian; load/save copy floats as they are in memory");
+constexpr std::uint32_t kVersion = 1;
+
+std::uint64_t xorshift(std::uint64_t& s) {
+    s ^= s << 13;
+    s ^= s >> 7;
+    s ^= s << 17;
+    return s;
+}
+
+float uniform(std::uint64_t& s, float range) { // Uniform in [-range, range]
+    return (static_cast<float>(xorshift(s) >> 40) / static_cast<float>(1 << 24) * 2.0f - 1.0f) * range;
+}
+} // namespace
+
+ValueNet::ValueNet()
+    : w1(kInputs * kHidden1), b1(kHidden1), w2(kHidden1 * kHidden2), b2(kHidden2), w3(kHidden2),
+      w1q(kInputs * kHidden1), b1q(kHidden1), w2q(kHidden1 * kHidden2) {}
+
+void ValueNet::randomize(std::uint64_t seed) {
+    std::uint64_t s = seed ? seed : 0x9E3779B97F4A7C15ULL;
+    const float r1 = 1.0f / std::sqrt(8.0f);                    // About eight inputs are active early on
+    const float r2 = std::sqrt(6.0f / (kHidden1 + kHidden2));   // Glorot-uniform for the dense layers
+    const float r3 = std::sqrt(6.0f / (kHidden2 + 1));
+    for (float& w : w1) w = uniform(s, r1);
+    for (float& w : w2) w = uniform(s, r2);
+    for (float& w : w3) w = uniform(s, r3);
+    std::fill(b1.begin(), b1.end(), 0.1f);                      // Start hidden units inside the clipped range
+    std::fill(b2.begin(), b2.end(), 0.0f);
+    b3 = 0.0f;
+    quantize();
+}
+
+// ──────────────────────────────────────────────────────────────
+// Weight files
+bool ValueNet::load(const std::string& path, std::string& error) {
+    AllocScope scope(AllocTag::Network);
+    std::ifstream in(path, std::ios::binary);
+    if (!in) { error = "cannot open " + path; return false; }
+    char magic[4];
+    std::uint32_t header[4]; // version, inputs, hidden1, hidden2
+    if (!in.read(magic, 4) || std::memcmp(magic, kMagic, 4) != 0) { error = path + ": not a TTTN weight file"; return false; }
+    if (!in.read(reinterpret_cast<char*>(header), sizeof header)) { error = path + ": truncated header"; return false; }
+    if (header[0] != kVersion) { error = path + ": unsupported version " + std::to_string(header[0]); return false; }
+    if (header[1] != kInputs || header[2] != kHidden1 || header[3] != kHidden2) {
+        error = path + ": layer sizes do not match this build";
+        return false;
+    }
+
+    ValueNet loaded;
+    auto read = [&in](std::vector<float>& v) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(v.data()), static_cast<std::streamsize>(v.size() * sizeof(float))));
+    };
+    if (!read(loaded.w1) || !read(loaded.b1) || !read(loaded.w2) || !read(loaded.b2) || !read(loaded.w3) ||
+        !in.read(reinterpret_cast<char*>(&loaded.b3), sizeof(float))) {
+        error = path + ": truncated weights";
+        return false;
+    }
+    loaded.precision = precision;
+    loaded.quantize();
+    *this = std::move(loaded);
+    return true;
+}
+
+bool ValueNet::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const std::uint32_t header[4] = {kVersion, kInputs, kHidden1, kHidden2};
+    out.write(kMagic, 4);
+    out.write(reinterpret_cast<const char*>(header), sizeof header);
+    for (const std::vector<float>* v : {&w1, &b1, &w2, &b2, &w3})
+        out.write(reinterpret_cast<const char*>(v->data()), static_cast<std::streamsize>(v->size() * sizeof(float)));
+    out.write(reinterpret_cast<const char*>(&b3), sizeof(float));
+    return static_cast<bool>(out);
+}
+
+// ──────────────────────────────────────────────────────────────
+// Inference
+int ValueNet::encode(const QubicBoard& board, Features& active) {
+    const char me = board.sideToMove();
+    const std::uint64_t mine = board.marks(me);
+    const std::uint64_t theirs = board.marks(me == 'X' ? 'O' : 'X');
+    int n = 0;
+    for (std::uint64_t m = mine; m; m &= m - 1) active[n++] = static_cast<std::uint8_t>(lowestBit64(m));
+    for (std::uint64_t m = theirs; m; m &= m - 1) active[n++] = static_cast<std::uint8_t>(64 + lowestBit64(m));
+    return n;
+}
+
+void ValueNet::quantize() {
+    for (size_t i = 0; i < w1.size(); ++i)
+        w1q[i] = static_cast<std::int16_t>(std::clamp<long>(std::lround(w1[i] * kQ1), -kW1Limit, kW1Limit));
+    for (size_t i = 0; i < b1.size(); ++i)
+        b1q[i] = static_cast<std::int16_t>(std::clamp<long>(std::lround(b1[i] * kQ1), -kW1Limit, kW1Limit));
+    for (size_t i = 0; i < w2.size(); ++i)
+        w2q[(i % kHidden2) * kHidden1 + i / kHidden2] = // Transposed: one contiguous row per output unit
+            static_cast<std::int16_t>(std::clamp<long>(std::lround(w2[i] * kQ2), -127, 127));
+}
+
+float ValueNet::evaluate(const QubicBoard& board) const {
+    float value;
+    evaluateBatch(&board, 1, &value);
+    return value;
+}
+
+void ValueNet::evaluateBatch(const QubicBoard* boards, int count, float* out) const {
+    TTT_COUNT_N(Counter::Evaluations, static_cast<std::uint64_t>(count > 0 ? count : 0));
+    for (int start = 0; start < count; start += kMaxBatch) {
+        const int n = std::min(kMaxBatch, count - start);
+        if (precision == Precision::INT8) forwardInt8(boards + start, n, out + start);
+        else forwardFloat(boards + start, n, out + start);
+    }
+}
+
+void ValueNet::forwardFloat(const QubicBoard* boards, int count, float* out) const {
+    alignas(32) float h1[kMaxBatch][kHidden1];
+    alignas(32) float h2[kMaxBatch][kHidden2];
+
+    for (int b = 0; b < count; ++b) { // Layer 1: bias plus one weight row per occupied cell
+        Features active;
+        const int n = encode(boards[b], active);
+        float* h = h1[b];
+        for (int j = 0; j < kHidden1; ++j) h[j] = b1[static_cast<size_t>(j)];
+        for (int f = 0; f < n; ++f) {
+            const float* row = &w1[static_cast<size_t>(active[static_cast<size_t>(f)]) * kHidden1];
+            for (int j = 0; j < kHidden1; ++j) h[j] += row[j];
+        }
+        for (int j = 0; j < kHidden1; ++j) h[j] = std::min(std::max(h[j], 0.0f), 1.0f); // Clipped ReLU
+    }
+
+    for (int b = 0; b < count; ++b)
+        for (int j = 0; j < kHidden2; ++j) h2[b][j] = b2[static_cast<size_t>(j)];
+    for (int i = 0; i < kHidden1; ++i) { // Layer 2: each weight row is loaded once for the whole batch
+        const float* row = &w2[static_cast<size_t>(i) * kHidden2];
+        for (int b = 0; b < count; ++b) {
+            const float a = h1[b][i];
+            for (int j = 0; j < kHidden2; ++j) h2[b][j] += a * row[j];
+        }
+    }
+
+    for (int b = 0; b < count; ++b) { // Output: ReLU, dot with w3, tanh
+        float sum = b3;
+        for (int j = 0; j < kHidden2; ++j) sum += std::max(h2[b][j], 0.0f) * w3[static_cast<size_t>(j)];
+        out[b] = std::tanh(sum);
+    }
+}
+
+void ValueNet::forwardInt8(const QubicBoard* boards, int count, float* out) const {
+    alignas(32) std::int16_t h1[kMaxBatch][kHidden1];
+    alignas(32) std::int32_t acc2[kMaxBatch][kHidden2];
+
+    for (int b = 0; b < count; ++b) {
+        Features active;
+        const int n = encode(boards[b], active);
+        std::int16_t* acc = h1[b]; // At most 64 rows of |w| <= kW1Limit plus the bias: no overflow
+        for (int j = 0; j < kHidden1; ++j) acc[j] = b1q[static_cast<size_t>(j)];
+        for (int f = 0; f < n; ++f) {
+            const std::int16_t* row = &w1q[static_cast<size_t>(active[static_cast<size_t>(f)]) * kHidden1];
+            for (int j = 0; j < kHidden1; ++j) acc[j] = static_cast<std::int16_t>(acc[j] + row[j]);
+        }
+        for (int j = 0; j < kHidden1; ++j) // Clipped ReLU maps [0, 1] onto 0..127
+            acc[j] = std::min<std::int16_t>(std::max<std::int16_t>(acc[j], 0), 127);
+    }
+
+    for (int b = 0; b < count; ++b) // Layer 2: 16-bit dot products with 32-bit sums (pmaddwd-style)
+        for (int j = 0; j < kHidden2; ++j) {
+            const std::int16_t* row = &w2q[static_cast<size_t>(j) * kHidden1];
+            std::int32_t sum = 0;
+            for (int i = 0; i < kHidden1; ++i) sum += h1[b][i] * row[i];
+            acc2[b][j] = sum;
+        }
+
+    constexpr float kScale = 1.0f / (kQ1 * kQ2);
+    for (int b = 0; b < count; ++b) {
+        float sum = b3;
+        for (int j = 0; j < kHidden2; ++j)
+            sum += std::max(static_cast<float>(acc2[b][j]) * kScale + b2[static_cast<size_t>(j)], 0.0f) * w3[static_cast<size_t>(j)];
+        out[b] = std::tanh(sum);
+    }
+}
+
+// ──────────────────────────────────────────────────────────────
+// Training
+float ValueNet::train(const std::vector<QubicBoard>& boards, const std::vector<float>& targets, float learningRate) {
+    const size_t count = std::min(boards.size(), targets.size());
+    if (count == 0) return 0.0f;
+
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; ++i) order[i] = i;
+    std::uint64_t s = 0x2545F4914F6CDD1DULL ^ count;
+    for (size_t i = count - 1; i > 0; --i) std::swap(order[i], order[xorshift(s) % (i + 1)]); // Fisher-Yates
+
+    double squaredError = 0.0;
+    float h1[kHidden1], h2[kHidden2], d1[kHidden1], d2[kHidden2];
+    for (size_t k : order) {
+        Features active;
+        const int n = encode(boards[k], active);
+
+        // Forward pass, keeping the activations for backprop
+        for (int j = 0; j < kHidden1; ++j) h1[j] = b1[static_cast<size_t>(j)];
+        for (int f = 0; f < n; ++f)
+            for (int j = 0; j < kHidden1; ++j) h1[j] += w1[static_cast<size_t>(active[static_cast<size_t>(f)]) * kHidden1 + static_cast<size_t>(j)];
+        for (int j = 0; j < kHidden2; ++j) h2[j] = b2[static_cast<size_t>(j)];
+        for (int i = 0; i < kHidden1; ++i) {
+            const float a = std::min(std::max(h1[i], 0.0f), 1.0f);
+            for (int j = 0; j < kHidden2; ++j) h2[j] += a * w2[static_cast<size_t>(i) * kHidden2 + static_cast<size_t>(j)];
+        }
+        float z = b3;
+        for (int j = 0; j < kHidden2; ++j) z += std::max(h2[j], 0.0f) * w3[static_cast<size_t>(j)];
+        const float y = std::tanh(z);
+        const float err = y - targets[k];
+        squaredError += static_cast<double>(err) * err;
+
+        // Backward pass (mean squared error, plain SGD)
+        const float dz = 2.0f * err * (1.0f - y * y);
+        for (int j = 0; j < kHidden2; ++j) d2[j] = h2[j] > 0.0f ? dz * w3[static_cast<size_t>(j)] : 0.0f;
+        for (int i = 0; i < kHidden1; ++i) {
+            float sum = 0.0f;
+            if (h1[i] > 0.0f && h1[i] < 1.0f)
+                for (int j = 0; j < kHidden2; ++j) sum += w2[static_cast<size_t>(i) * kHidden2 + static_cast<size_t>(j)] * d2[j];
+            d1[i] = sum;
+        }
+
+        for (int j = 0; j < kHidden2; ++j) w3[static_cast<size_t>(j)] -= learningRate * dz * std::max(h2[j], 0.0f);
+        b3 -= learningRate * dz;
+        for (int i = 0; i < kHidden1; ++i) {
+            const float a = std::min(std::max(h1[i], 0.0f), 1.0f);
+            for (int j = 0; j < kHidden2; ++j) w2[static_cast<size_t>(i) * kHidden2 + static_cast<size_t>(j)] -= learningRate * a * d2[j];
+        }
+        for (int j = 0; j < kHidden2; ++j) b2[static_cast<size_t>(j)] -= learningRate * d2[j];
+        for (int f = 0; f < n; ++f)
+            for (int j = 0; j < kHidden1; ++j) w1[static_cast<size_t>(active[static_cast<size_t>(f)]) * kHidden1 + static_cast<size_t>(j)] -= learningRate * d1[j];
+        for (int j = 0; j < kHidden1; ++j) b1[static_cast<size_t>(j)] -= learningRate * d1[j];
+    }
+    quantize();
+    return static_cast<float>(squaredError / static_cast<double>(count));
+}
+
+ValueNet ValueNet::distill(int positions, int epochs, std::uint64_t seed) {
+    std::uint64_t s = seed ? seed : 0x5DEECE66DULL;
+    std::vector<QubicBoard> boards;
+    std::vector<float> targets;
+    boards.reserve(static_cast<size_t>(positions));
+    targets.reserve(static_cast<size_t>(positions));
+    while (static_cast<int>(boards.size()) < positions) { // Random play to a random depth, running positions only
+        QubicBoard board;
+        std::array<std::uint8_t, 64> moves;
+        const int plies = static_cast<int>(xorshift(s) % 40);
+        for (int ply = 0; ply < plies && board.state() == GameState::RUNNING; ++ply)
+            board.play(moves[xorshift(s) % static_cast<std::uint64_t>(board.legalMoves(moves))]);
+        if (board.state() != GameState::RUNNING) continue;
+        boards.push_back(board);
+        targets.push_back(std::tanh(static_cast<float>(QubicSearch::evaluate(board)) / 128.0f));
+    }
+
+    ValueNet net;
+    net.randomize(s);
+    for (int e = 0; e < epochs; ++e) net.train(boards, targets, 0.01f);
+    return net;
+}
@@ -0,0 +1,81 @@
+#pragma once // Ensure the header is included only once during compilation
+#include "QubicBoard.h" // Positions are encoded straight from the two bitboards
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Small MLP value network for Qubic, evaluated on the CPU.
+//
+// Inputs are 128 binary features: the side to move's 64 cells followed by the
+// opponent's 64 cells. Two hidden layers (clipped ReLU, ReLU) feed a tanh
+// output in [-1, 1] from the side to move's point of view.
+//
+// The first layer is an accumulation of weight rows for the occupied cells,
+// so its cost scales with the number of marks rather than with 128 inputs.
+// Every other layer is a fixed-size loop over contiguous rows, written so
+// the compiler vectorizes it (-O2/-O3, wider with TICTACTOE_NATIVE).
+// evaluateBatch() runs the dense layers as a batch x row product, which keeps
+// the weights in cache across many leaves. Precision::INT8 runs a quantized
+// copy (int16 first layer, int8-range second layer with int32 sums) made by
+// quantize() whenever the float weights change.
+//
+// Weight files ("TTTN", see load/save) are little-endian float32 (only
+// little-endian hosts build, as the floats are copied as-is) in the order
+// w1, b1, w2, b2, w3, b3. distill() fits a network to QubicSearch's line
+// heuristic, which gives a working starting point without outside data.
+class ValueNet {
+public:
+    static constexpr int kInputs = 128;
+    static constexpr int kHidden1 = 64;
+    static constexpr int kHidden2 = 32;
+    static constexpr int kMaxBatch = 64;                         // evaluateBatch splits larger batches
+
+    enum class Precision { FLOAT, INT8 };
+
+    ValueNet();                                                  // All-zero weights: every position scores 0
+
+    void randomize(std::uint64_t seed);                          // Small uniform weights, for training from scratch
+    bool load(const std::string& path, std::string& error);      // false (weights unchanged) on a bad file
+    bool save(const std::string& path) const;
+
+    void setPrecision(Precision p) { precision = p; }
+    Precision getPrecision() const { return precision; }
+
+    float evaluate(const QubicBoard& board) const;               // Value for the side to move, in [-1, 1]
+    void evaluateBatch(const QubicBoard* boards, int count, float* out) const;
+
+    // One SGD pass over the samples (float weights), returns the mean squared error before the updates.
+    float train(const std::vector<QubicBoard>& boards, const std::vector<float>& targets, float learningRate);
+
+    // Network fitted to tanh(QubicSearch::evaluate / 128) on positions from random play.
+    static ValueNet distill(int positions, int epochs, std::uint64_t seed);
+
+private:
+    using Features = std::array<std::uint8_t, 64>;               // Indices of the active inputs
+    static int encode(const QubicBoard& board, Features& active); // Returns the active count
+
+    void quantize();                                             // Refresh the INT8 copy from the float weights
+
+    // Float weights, input-major so each layer is a sum of contiguous rows.
+    std::vector<float> w1;                                       // [kInputs][kHidden1]
+    std::vector<float> b1;                                       // [kHidden1]
+    std::vector<float> w2;                                       // [kHidden1][kHidden2]
+    std::vector<float> b2;                                       // [kHidden2]
+    std::vector<float> w3;                                       // [kHidden2]
+    float b3 = 0.0f;
+
+    // Quantized copy: hidden1 activations are 0..127, w1 has scale kQ1, w2 scale kQ2.
+    // w1/b1 are clamped so 64 active rows plus the bias still sum inside int16.
+    static constexpr float kQ1 = 127.0f;
+    static constexpr float kQ2 = 64.0f;
+    static constexpr long kW1Limit = 32767 / 65;
+    std::vector<std::int16_t> w1q;                               // [kInputs][kHidden1]
+    std::vector<std::int16_t> b1q;                               // [kHidden1]
+    std::vector<std::int16_t> w2q;                               // [kHidden2][kHidden1], int8 range
+
+    Precision precision = Precision::FLOAT;
+
+    void forwardFloat(const QubicBoard* boards, int count, float* out) const;
+    void forwardInt8(const QubicBoard* boards, int count, float* out) const;
+};
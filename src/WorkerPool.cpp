@@ -0,0 +1,43 @@
+#include "WorkerPool.h" // Worker pool declarations
+#include <algorithm>    // std::max
+
+WorkerPool::WorkerPool(int threads) {
+    if (threads <= 0) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    workers.reserve(static_cast<size_t>(threads));
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([this] {
+            for (;;) {
+                std::function<void()> job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+                    if (jobs.empty()) return; // Stopping and drained
+                    job = std::move(jobs.front());
+                    jobs.pop_front();
+                }
+                job();
+            }
+        });
+}
+
+WorkerPool::~WorkerPool() {
+    shutdown();
+}
+
+void WorkerPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& w : workers)
+        if (w.joinable()) w.join();
+}
+
+void WorkerPool::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    wake.notify_one();
+}
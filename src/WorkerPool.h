@@ -0,0 +1,28 @@
+#pragma once // Ensure the header is included only once during compilation
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads running submitted jobs in FIFO order. Used to take AI
+// thinking off the event-loop thread; the destructor finishes queued jobs.
+class WorkerPool {
+public:
+    explicit WorkerPool(int threads); // threads <= 0 means hardware concurrency
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void submit(std::function<void()> job);
+    void shutdown(); // Run the queued jobs, then join every worker; idempotent
+    int size() const { return static_cast<int>(workers.size()); }
+
+private:
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::function<void()>> jobs;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+};
@@ -1,6 +1,355 @@
-#include "Interface.h" // Include the header file for the Interface class
- 
-int main() { // Main entry point of the program
-    Interface ui; // Create an instance of the Interface class
-    return ui.run(); // Call the run method of Interface and return its result
-}
\ No newline at end of file
+#include "AllocProfile.h" // Heap allocations per subsystem and per move (--alloc-profile)
+#include "AsyncInterface.h" // Coroutine sessions (--async, --serve)
+#include "Benchmark.h"  // --bench suites
+#include "Differential.h" // Reference-vs-optimized rules checker (--fuzz)
+#include "Enumerator.h" // Exhaustive 3x3/4x4 tree statistics (--enumerate)
+#include "Interface.h"  // Include the header file for the Interface class
+#include "Latency.h"    // computerMove latency percentiles
+#include "MoveCache.h"  // Qubic reply cache (--move-cache)
+#include "Profiler.h"   // Aggregated counter/timer dump at exit
+#include "SessionLog.h" // Console session recording (--record, --replay)
+#include "Simulation.h" // Headless self-play batch mode
+#include "StartupProfile.h" // Setup stages up to the first computerMove (--startup-profile)
+#include "TrainingData.h" // Self-play training records (--gen-data)
+#include "Tournament.h" // Multi-process round robin with Elo and SPRT (--tournament)
+#include "ValueNet.h"   // Learned Qubic evaluator (--nn, --nn-train)
+#include <chrono>       // Replay wall time
+#include <cstdlib>      // std::strtoll / std::strtod for numeric flag values
+#include <cstring>      // std::strcmp for flag matching
+#include <iostream>
+#include <memory>       // The move cache lives for the whole session
+#include <random>       // std::random_device for recording seeds
+
+namespace {
+void usage(const char* argv0) {
+    std::cerr << "Usage: " << argv0 << " [--variant classic|ultimate|qubic] [--agent alphabeta|mcts] [--move-ms MS]\n"
+              << "       [--simulate GAMES [--threads N] [--batch]] [--bench " << Benchmark::suiteNames() << "]\n"
+              << "       [--nn WEIGHTS [--nn-int8]] [--nn-train OUT] [--gen-data DIR [--simulate GAMES]]\n"
+              << "       [--difficulty random|adaptive|perfect [--target-rate R]]\n"
+              << "       [--async | --serve SOCKET [--threads N]] [--fuzz GAMES [--threads N]]\n"
+              << "       [--enumerate 3x3|4x4|POSITION [--threads N]]\n"
+              << "       [--tournament AGENTS [--simulate GAMES_PER_PAIR] [--threads WORKERS] [--sprt ELO0:ELO1]]\n"
+              << "       [--move-cache MB] [--move-cache-file PATH] [--coach]\n"
+              << "       [--record LOG [--seed N] | --replay LOG]\n"
+              << "       [--latency] [--profile[=text|json]] [--startup-profile] [--alloc-profile [--alloc-budget N]]\n";
+}
+} // namespace
+
+int main(int argc, char** argv) { // Main entry point of the program
+    bool startupProfile = false; // Checked before anything else so flag parsing is on the clock too
+    for (int i = 1; i < argc; ++i) startupProfile |= std::strcmp(argv[i], "--startup-profile") == 0;
+    if (startupProfile) StartupProfile::start();
+    bool allocProfile = false; // Also started before parsing, so setup allocations are in the report
+    long long allocBudget = -1; // --alloc-budget: most allocations one CPU move may make (-1 = no limit)
+    for (int i = 1; i < argc; ++i) {
+        allocProfile |= std::strcmp(argv[i], "--alloc-profile") == 0;
+        if (std::strcmp(argv[i], "--alloc-budget") == 0 && i + 1 < argc) allocBudget = std::strtoll(argv[i + 1], nullptr, 10);
+    }
+    if (allocProfile || allocBudget >= 0) AllocProfile::start();
+    if (allocBudget >= 0 && !AllocProfile::available()) { // Nothing would be counted, so every budget would pass
+        std::cerr << "--alloc-budget needs the allocation hooks, which this build does not have (glibc only)\n";
+        return 2;
+    }
+
+    enum class ProfileDump { NONE, TEXT, JSON };
+    ProfileDump dump = ProfileDump::NONE;
+    bool latency = false;     // Print computerMove percentiles at exit
+    long long simulate = 0;   // > 0: run that many CPU-vs-CPU games instead of the interactive loop
+    int threads = 0;          // Simulation worker threads (0 = hardware concurrency)
+    bool batch = false;       // Random 3x3 self-play through the structure-of-arrays batch engine
+    Variant variant = Variant::CLASSIC;
+    QubicAgent agent = QubicAgent::ALPHA_BETA; // Search agent for Qubic
+    int moveMs = -1;          // Per-move time budget for search agents (-1 = variant default)
+    const char* bench = nullptr; // Benchmark suite to run instead of playing
+    const char* nnPath = nullptr;  // Qubic value network weights
+    bool nnInt8 = false;           // Run the network's quantized path
+    const char* nnTrain = nullptr; // Distill a network from the Qubic heuristic and write it here
+    const char* dataDir = nullptr; // Write 3x3 self-play training shards here
+    Difficulty difficulty = Difficulty::RANDOM; // Classic CPU opponent
+    double targetRate = 0.4;       // Adaptive opponent: human score per round to aim for
+    bool async = false;            // Play on stdin/stdout through the coroutine event loop
+    const char* servePath = nullptr; // Host sessions on this Unix socket
+    long long fuzzGames = 0;       // > 0: differential-check that many random games
+    const char* tournament = nullptr; // Comma-separated agents for a round robin
+    const char* enumerate = nullptr; // Board or position whose full game tree to tally
+    const char* sprt = nullptr;    // "ELO0:ELO1" SPRT hypotheses for the tournament
+    long long cacheMb = 16;        // Qubic reply cache budget for interactive play (0 = off)
+    const char* cacheFile = nullptr; // Warm-start the reply cache from here and save it back at exit
+    bool coach = false;            // Classic: label empty cells with their value on the human's turn
+    const char* recordPath = nullptr; // Log the seed, input and CPU replies of the console session here
+    const char* replayPath = nullptr; // Re-run a recorded session headlessly and check its replies
+    long long seed = 0;            // Recording seed (0 = pick one)
+
+    for (int i = 1; i < argc; ++i) { // Parse command-line flags
+        auto value = [&]() -> long long { // Numeric argument following the current flag
+            if (i + 1 >= argc) { usage(argv[0]); std::exit(2); }
+            return std::strtoll(argv[++i], nullptr, 10);
+        };
+        if (std::strcmp(argv[i], "--profile") == 0 || std::strcmp(argv[i], "--profile=text") == 0) {
+            dump = ProfileDump::TEXT;
+        } else if (std::strcmp(argv[i], "--profile=json") == 0) {
+            dump = ProfileDump::JSON;
+        } else if (std::strcmp(argv[i], "--latency") == 0) {
+            latency = true;
+        } else if (std::strcmp(argv[i], "--startup-profile") == 0 || std::strcmp(argv[i], "--alloc-profile") == 0) {
+            // Handled above
+        } else if (std::strcmp(argv[i], "--alloc-budget") == 0) {
+            value(); // Handled above
+        } else if (std::strcmp(argv[i], "--simulate") == 0) {
+            simulate = value();
+        } else if (std::strcmp(argv[i], "--batch") == 0) {
+            batch = true;
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            threads = static_cast<int>(value());
+        } else if (std::strcmp(argv[i], "--move-ms") == 0) {
+            moveMs = static_cast<int>(value());
+        } else if (std::strcmp(argv[i], "--variant") == 0 && i + 1 < argc) {
+            const char* v = argv[++i];
+            if (std::strcmp(v, "classic") == 0) variant = Variant::CLASSIC;
+            else if (std::strcmp(v, "ultimate") == 0) variant = Variant::ULTIMATE;
+            else if (std::strcmp(v, "qubic") == 0) variant = Variant::QUBIC;
+            else { usage(argv[0]); return 2; }
+        } else if (std::strcmp(argv[i], "--agent") == 0 && i + 1 < argc) {
+            const char* a = argv[++i];
+            if (std::strcmp(a, "alphabeta") == 0) agent = QubicAgent::ALPHA_BETA;
+            else if (std::strcmp(a, "mcts") == 0) agent = QubicAgent::MCTS;
+            else { usage(argv[0]); return 2; }
+        } else if (std::strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            bench = argv[++i];
+        } else if (std::strcmp(argv[i], "--nn") == 0 && i + 1 < argc) {
+            nnPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--nn-int8") == 0) {
+            nnInt8 = true;
+        } else if (std::strcmp(argv[i], "--nn-train") == 0 && i + 1 < argc) {
+            nnTrain = argv[++i];
+        } else if (std::strcmp(argv[i], "--gen-data") == 0 && i + 1 < argc) {
+            dataDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--difficulty") == 0 && i + 1 < argc) {
+            const char* d = argv[++i];
+            if (std::strcmp(d, "random") == 0) difficulty = Difficulty::RANDOM;
+            else if (std::strcmp(d, "adaptive") == 0) difficulty = Difficulty::ADAPTIVE;
+            else if (std::strcmp(d, "perfect") == 0) difficulty = Difficulty::PERFECT;
+            else { usage(argv[0]); return 2; }
+        } else if (std::strcmp(argv[i], "--target-rate") == 0 && i + 1 < argc) {
+            targetRate = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--fuzz") == 0) {
+            fuzzGames = value();
+        } else if (std::strcmp(argv[i], "--enumerate") == 0 && i + 1 < argc) {
+            enumerate = argv[++i];
+        } else if (std::strcmp(argv[i], "--tournament") == 0 && i + 1 < argc) {
+            tournament = argv[++i];
+        } else if (std::strcmp(argv[i], "--sprt") == 0 && i + 1 < argc) {
+            sprt = argv[++i];
+        } else if (std::strcmp(argv[i], "--move-cache") == 0) {
+            cacheMb = value();
+        } else if (std::strcmp(argv[i], "--move-cache-file") == 0 && i + 1 < argc) {
+            cacheFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            seed = value();
+        } else if (std::strcmp(argv[i], "--coach") == 0) {
+            coach = true;
+        } else if (std::strcmp(argv[i], "--async") == 0) {
+            async = true;
+        } else if (std::strcmp(argv[i], "--serve") == 0 && i + 1 < argc) {
+            servePath = argv[++i];
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    SessionLog session;
+    if (replayPath) { // The recording decides what is played; flags only add reports
+        std::string error;
+        if (!session.load(replayPath, error)) {
+            std::cerr << error << "\n";
+            return 2;
+        }
+        const SessionHeader& h = session.header();
+        variant = h.variant;
+        difficulty = h.difficulty;
+        targetRate = h.targetRate;
+        agent = h.agent;
+        moveMs = h.moveMs;
+        cacheFile = nullptr; // Start cold, as the recording did unless it was warm-started
+    }
+    if ((recordPath || replayPath) && (async || servePath)) {
+        std::cerr << "--record and --replay apply to the console game only.\n";
+        return 2;
+    }
+    if (batch && (variant != Variant::CLASSIC || difficulty != Difficulty::RANDOM)) {
+        std::cerr << "--batch runs random classic self-play only.\n";
+        usage(argv[0]);
+        return 2;
+    }
+
+    StartupProfile::mark("parse flags");
+
+    ValueNet net;
+    if (nnPath) {
+        std::string error;
+        if (!net.load(nnPath, error)) {
+            std::cerr << error << "\n";
+            return 2;
+        }
+        net.setPrecision(nnInt8 ? ValueNet::Precision::INT8 : ValueNet::Precision::FLOAT);
+        StartupProfile::mark("load value net");
+    }
+    const ValueNet* valueNet = nnPath ? &net : nullptr;
+
+    const bool interactive = !nnTrain && !dataDir && !tournament && !enumerate && fuzzGames <= 0 && !bench && simulate <= 0;
+    std::unique_ptr<MoveCache> cache; // Only interactive Qubic play consults it
+    if (interactive && cacheMb > 0 && variant == Variant::QUBIC) {
+        cache = std::make_unique<MoveCache>(static_cast<std::size_t>(cacheMb) << 20);
+        std::string error;
+        if (cacheFile && !cache->load(cacheFile, error)) std::cerr << error << " (starting cold)\n";
+        StartupProfile::mark("move cache");
+    }
+
+    int rc = 0;
+    if (nnTrain) {
+        ValueNet trained = ValueNet::distill(50000, 40, 0);
+        if (!trained.save(nnTrain)) {
+            std::cerr << "Cannot write " << nnTrain << "\n";
+            return 2;
+        }
+        std::cout << "Wrote " << nnTrain << "\n";
+    } else if (dataDir) {
+        DataGenStats stats = TrainingData::generate(dataDir, simulate > 0 ? simulate : 10000, threads, std::cerr);
+        std::cout << "Generated " << stats.records << " records from " << stats.games << " games in " << stats.shards
+                  << " shards (" << stats.duplicates << " duplicates dropped, " << stats.seconds << " s)\n";
+    } else if (enumerate) {
+        int side = 3;
+        std::uint64_t x = 0, o = 0;
+        std::string error;
+        if (!Enumerator::parseRoot(enumerate, side, x, o, error)) {
+            std::cerr << error << "\n";
+            return 2;
+        }
+        Enumerator::printSummary(Enumerator::run(side, x, o, threads), std::cout);
+    } else if (tournament) {
+        TournamentOptions options;
+        if (!Tournament::parseAgents(tournament, options.agents)) {
+            std::cerr << "--tournament needs two or more distinct agents from random, adaptive, perfect\n";
+            return 2;
+        }
+        if (simulate > 0) options.gamesPerPair = simulate;
+        options.workers = threads;
+        if (sprt) { // Explicit hypotheses also turn on early stopping
+            options.sprtStop = true;
+            char* rest = nullptr;
+            options.sprtElo0 = std::strtod(sprt, &rest);
+            if (*rest != ':') { usage(argv[0]); return 2; }
+            options.sprtElo1 = std::strtod(rest + 1, nullptr);
+        }
+        TournamentStats stats = Tournament::run(options, std::cerr);
+        Tournament::printSummary(stats, std::cout);
+    } else if (fuzzGames > 0) {
+        DifferentialStats stats = Differential::run(fuzzGames, threads, 0x7474u);
+        Differential::printSummary(stats, std::cout);
+        if (stats.divergences > 0) rc = 1;
+    } else if (bench) {
+        if (!Benchmark::run(bench, std::cout)) {
+            usage(argv[0]);
+            return 2;
+        }
+    } else if (simulate > 0) {
+        SimulationStats stats;
+        if (variant == Variant::ULTIMATE) stats = Simulation::selfPlayUltimate(simulate, threads, moveMs > 0 ? moveMs : 100);
+        else if (variant == Variant::QUBIC) stats = Simulation::selfPlayQubic(simulate, threads, agent, moveMs > 0 ? moveMs : 100, valueNet);
+        else if (batch) stats = Simulation::selfPlayBatch(simulate, threads);
+        else stats = Simulation::selfPlay(simulate, threads, difficulty);
+        Simulation::printSummary(stats, std::cout);
+        if (!batch) LatencyRecorder::report(std::cout); // The batch engine plays lanes in lockstep and times no single move
+    } else if (variant == Variant::ULTIMATE) {
+        std::cerr << "The ultimate variant is currently available in --simulate mode only.\n";
+        rc = 2;
+    } else if (async || servePath) {
+        AsyncOptions options;
+        options.variant = variant;
+        options.agent = agent;
+        options.moveMs = moveMs > 0 ? moveMs : 500;
+        options.net = valueNet;
+        options.difficulty = difficulty;
+        options.targetRate = targetRate;
+        options.threads = threads;
+        options.cache = cache.get();
+        options.coach = coach;
+        AsyncInterface ui(options);
+        StartupProfile::mark("event loop and workers");
+        rc = servePath ? ui.serve(servePath) : ui.runStdio();
+        if (latency) LatencyRecorder::report(std::cerr);
+    } else {
+        Interface ui(variant, agent, moveMs > 0 ? moveMs : 500, valueNet); // Create an instance of the Interface class
+        StartupProfile::mark("interface");
+        ui.setDifficulty(difficulty, targetRate);
+        StartupProfile::mark("opponent tables"); // Solver and move-tier tables for the solved-table difficulties
+        ui.setMoveCache(cache.get());
+        ui.setCoach(coach);
+        if (recordPath) {
+            SessionHeader header;
+            header.seed = seed ? static_cast<std::uint64_t>(seed)
+                               : (static_cast<std::uint64_t>(std::random_device{}()) << 32) ^
+                                     static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+            header.variant = variant;
+            header.difficulty = difficulty;
+            header.targetRate = targetRate;
+            header.agent = agent;
+            header.moveMs = moveMs > 0 ? moveMs : 500;
+            std::string error;
+            if (!session.record(recordPath, header, error)) {
+                std::cerr << error << "\n";
+                return 2;
+            }
+        }
+        if (recordPath || replayPath) {
+            ui.seed(session.header().seed);
+            ui.setSessionLog(&session);
+        }
+        if (replayPath) { // Headless: the board and prompts go nowhere
+            std::streambuf* console = std::cout.rdbuf(nullptr);
+            const auto start = std::chrono::steady_clock::now();
+            rc = ui.run();
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::cout.rdbuf(console); // Also clears the badbit the null buffer set
+            session.finish();
+            std::cout << "Replayed " << session.inputs() << " input lines and " << session.replies() << " CPU replies in "
+                      << ms << " ms\n";
+            if (session.divergences()) {
+                std::cout << session.divergences() << " divergence(s); first: " << session.firstDivergence() << "\n";
+                rc = 1; // Lets `git bisect run` find the commit that changed behaviour
+            } else {
+                std::cout << "All replies match the recording\n";
+            }
+        } else {
+            rc = ui.run(); // Run the interactive game loop
+        }
+        if (latency) LatencyRecorder::report(std::cerr); // Reports go to stderr so they never mix with the board
+    }
+
+    if (cache) {
+        if (cacheFile && !cache->save(cacheFile)) std::cerr << "Cannot write " << cacheFile << "\n";
+        if (dump != ProfileDump::NONE) cache->printStats(std::cerr);
+    }
+    if (startupProfile) StartupProfile::report(std::cerr);
+    if (AllocProfile::active()) {
+        AllocProfile::footprint("sizeof(Interface)", sizeof(Interface)); // Per console session, before its heap buffers
+        AllocProfile::footprint("sizeof(TicTacToe)", sizeof(TicTacToe));
+        AllocProfile::footprint("sizeof(Qubic)", sizeof(Qubic));
+        if (cache) AllocProfile::footprint("move cache table (calloc)", cache->tableBytes());
+        AllocProfile::report(std::cerr);
+        if (allocBudget >= 0 && AllocProfile::maxPerMove() > static_cast<std::uint64_t>(allocBudget)) {
+            std::cerr << "Allocation budget exceeded: a CPU move made " << AllocProfile::maxPerMove()
+                      << " allocations (budget " << allocBudget << ")\n";
+            if (rc == 0) rc = 1;
+        }
+    }
+    if (dump == ProfileDump::TEXT) Profiler::dumpText(std::cerr);
+    if (dump == ProfileDump::JSON) Profiler::dumpJson(std::cerr);
+    return rc;
+}